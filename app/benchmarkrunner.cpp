@@ -0,0 +1,262 @@
+#include "benchmarkrunner.h"
+#include "connectionpool.h"
+#include "invocationcomparer.h"
+#include "modulesession.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaMethod>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <iostream>
+
+namespace {
+
+bool findMethod(QObject* target, const QString& name, int argCount, QMetaMethod* found)
+{
+    const QMetaObject* metaObject = target->metaObject();
+    for (int i = metaObject->methodOffset(); i < metaObject->methodCount(); ++i) {
+        QMetaMethod method = metaObject->method(i);
+        if (method.methodType() == QMetaMethod::Signal) {
+            continue;
+        }
+        if (QString::fromUtf8(method.name()) == name && method.parameterCount() == argCount) {
+            *found = method;
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+QVector<BenchmarkCall> BenchmarkRunner::loadCalls(const QString& path, QString* error)
+{
+    QVector<BenchmarkCall> calls;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = QString("Cannot open call file %1: %2").arg(path, file.errorString());
+        }
+        return calls;
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isArray()) {
+        if (error) {
+            *error = QString("Call file %1 is not a JSON array: %2").arg(path, parseError.errorString());
+        }
+        return calls;
+    }
+
+    for (const QJsonValue& value : doc.array()) {
+        QJsonObject obj = value.toObject();
+        BenchmarkCall call;
+        call.method = obj.value("method").toString();
+        call.args = obj.value("args").toArray().toVariantList();
+        call.iterations = qMax(1, obj.value("iterations").toInt(100));
+        if (call.method.isEmpty()) {
+            if (error) {
+                *error = QString("Call file %1 has an entry without a method").arg(path);
+            }
+            return QVector<BenchmarkCall>();
+        }
+        calls.append(call);
+    }
+    return calls;
+}
+
+bool BenchmarkRunner::saveCalls(const QString& path, const QVector<BenchmarkCall>& calls, QString* error)
+{
+    QJsonArray array;
+    for (const BenchmarkCall& call : calls) {
+        QJsonObject obj;
+        obj["method"] = call.method;
+        obj["args"] = QJsonArray::fromVariantList(call.args);
+        obj["iterations"] = call.iterations;
+        array.append(obj);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    file.write(QJsonDocument(array).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        if (error) {
+            *error = file.errorString();
+        }
+        return false;
+    }
+    return true;
+}
+
+QVector<BenchmarkCall> BenchmarkRunner::defaultCalls(QObject* target, int iterations)
+{
+    QVector<BenchmarkCall> calls;
+    const QMetaObject* metaObject = target->metaObject();
+    for (int i = metaObject->methodOffset(); i < metaObject->methodCount(); ++i) {
+        QMetaMethod method = metaObject->method(i);
+        if (method.methodType() == QMetaMethod::Signal || method.parameterCount() > 0
+            || InvocationComparer::mayHaveSideEffects(method)) {
+            continue;
+        }
+        BenchmarkCall call;
+        call.method = QString::fromUtf8(method.name());
+        call.iterations = iterations;
+        calls.append(call);
+    }
+    return calls;
+}
+
+QStringList BenchmarkRunner::methodSchema(QObject* target)
+{
+    QStringList schema;
+    const QMetaObject* metaObject = target->metaObject();
+    for (int i = metaObject->methodOffset(); i < metaObject->methodCount(); ++i) {
+        QMetaMethod method = metaObject->method(i);
+        if (method.methodType() == QMetaMethod::Signal) {
+            continue;
+        }
+        QString returnType = QString::fromUtf8(method.typeName());
+        if (returnType.isEmpty()) {
+            returnType = "void";
+        }
+        schema << QString("%1 %2").arg(returnType, QString::fromUtf8(method.methodSignature()));
+    }
+    schema.sort();
+    return schema;
+}
+
+bool BenchmarkRunner::prepareCall(QObject* target, const BenchmarkCall& call, QMetaMethod* method,
+                                  QVariantList* args, QString* error)
+{
+    if (!findMethod(target, call.method, call.args.size(), method)) {
+        if (error) {
+            *error = QString("No method %1 taking %2 arguments").arg(call.method).arg(call.args.size());
+        }
+        return false;
+    }
+
+    args->clear();
+    for (int p = 0; p < call.args.size(); ++p) {
+        QVariant arg = call.args.at(p);
+        if (arg.metaType() != method->parameterMetaType(p) && !arg.convert(method->parameterMetaType(p))) {
+            if (error) {
+                *error = QString("Argument %1 cannot be converted to %2").arg(p).arg(QString::fromUtf8(method->parameterTypeName(p)));
+            }
+            return false;
+        }
+        args->append(arg);
+    }
+    return true;
+}
+
+QJsonObject BenchmarkRunner::run(ModuleSession* session, const QVector<BenchmarkCall>& calls, int warmupCalls)
+{
+    QJsonObject output;
+    QObject* target = session->pluginInstance();
+    output["module"] = session->modulePath();
+    output["name"] = session->moduleName();
+    output["version"] = session->metaData().value("version").toString();
+    output["schema"] = QJsonArray::fromStringList(methodSchema(target));
+
+    QJsonArray callResults;
+    for (const BenchmarkCall& call : calls) {
+        QJsonObject callResult;
+        callResult["method"] = call.method;
+
+        QMetaMethod method;
+        QVariantList args;
+        QString prepareError;
+        if (!prepareCall(target, call, &method, &args, &prepareError)) {
+            if (method.isValid()) {
+                callResult["signature"] = QString::fromUtf8(method.methodSignature());
+            }
+            callResult["error"] = prepareError;
+            callResults.append(callResult);
+            continue;
+        }
+        callResult["signature"] = QString::fromUtf8(method.methodSignature());
+
+        const bool expectsResult = method.returnMetaType().id() != QMetaType::Void;
+        auto callOnce = [&](double* elapsedMs) {
+            bool ok = false;
+            QElapsedTimer timer;
+            timer.start();
+            QVariant result = session->invokeRemote(call.method, args, &ok);
+            *elapsedMs = timer.nsecsElapsed() / 1e6;
+            return ok && (!expectsResult || result.isValid());
+        };
+
+        double elapsedMs = 0.0;
+        for (int i = 0; i < warmupCalls; ++i) {
+            callOnce(&elapsedMs);
+        }
+
+        QJsonArray samples;
+        int failures = 0;
+        for (int i = 0; i < call.iterations; ++i) {
+            if (callOnce(&elapsedMs)) {
+                samples.append(elapsedMs);
+            } else {
+                ++failures;
+            }
+        }
+        callResult["samplesMs"] = samples;
+        callResult["failures"] = failures;
+        std::cout << "Benchmarked " << call.method.toStdString() << ": " << samples.size() << " calls, "
+                  << failures << " failures" << std::endl;
+        callResults.append(callResult);
+    }
+    output["calls"] = callResults;
+    return output;
+}
+
+int BenchmarkRunner::runChild(const QString& modulePath, const QString& callsPath, const QString& outputPath)
+{
+    QJsonObject output;
+    int exitCode = 0;
+    {
+        ModuleSession session;
+        QString error;
+        if (!session.load(modulePath, &error)) {
+            output["module"] = modulePath;
+            output["error"] = error;
+            exitCode = 2;
+        } else {
+            session.connectionPool()->warmUp(session.moduleName());
+            // Without a call file the list comes from this build's own
+            // methods and may differ from the other build's; the comparison
+            // matches calls by signature, not by position.
+            QVector<BenchmarkCall> calls = callsPath.isEmpty()
+                ? defaultCalls(session.pluginInstance())
+                : loadCalls(callsPath, &error);
+            if (!error.isEmpty()) {
+                output["module"] = modulePath;
+                output["error"] = error;
+                exitCode = 2;
+            } else {
+                output = run(&session, calls);
+            }
+        }
+    }
+
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "Cannot write benchmark output " << outputPath.toStdString() << std::endl;
+        return 2;
+    }
+    file.write(QJsonDocument(output).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        std::cerr << "Cannot write benchmark output " << outputPath.toStdString() << std::endl;
+        return 2;
+    }
+    return exitCode;
+}
@@ -0,0 +1,55 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+class QObject;
+class QMetaMethod;
+class ModuleSession;
+
+// One entry of a call file:
+//   [{"method": "getBalance", "args": ["0xabc"], "iterations": 200}, ...]
+// args are JSON values converted to the method's parameter types.
+struct BenchmarkCall
+{
+    QString method;
+    QVariantList args;
+    int iterations = 100;
+};
+
+// Runs a fixed set of remote calls against one loaded module and records
+// every call's latency. This is the per-build half of an A/B comparison; it
+// runs in its own process (--bench) so each build gets its own logos core
+// and host.
+class BenchmarkRunner
+{
+public:
+    static QVector<BenchmarkCall> loadCalls(const QString& path, QString* error = nullptr);
+    static bool saveCalls(const QString& path, const QVector<BenchmarkCall>& calls, QString* error = nullptr);
+
+    // Every method without parameters that does not look like it changes state.
+    static QVector<BenchmarkCall> defaultCalls(QObject* target, int iterations = 100);
+
+    // "ReturnType signature" of each invokable method the module declares,
+    // sorted; two builds with the same schema can be compared call for call.
+    static QStringList methodSchema(QObject* target);
+
+    // Finds the method the call names and converts its arguments to the
+    // method's parameter types.
+    static bool prepareCall(QObject* target, const BenchmarkCall& call, QMetaMethod* method,
+                            QVariantList* args, QString* error = nullptr);
+
+    // Result object:
+    //   {"module": ..., "name": ..., "version": ..., "schema": [...],
+    //    "calls": [{"method", "signature", "samplesMs": [...], "failures", "error"}]}
+    static QJsonObject run(ModuleSession* session, const QVector<BenchmarkCall>& calls, int warmupCalls = 3);
+
+    // Entry point of the --bench child process. Returns the exit code.
+    static int runChild(const QString& modulePath, const QString& callsPath, const QString& outputPath);
+};
+
+#endif // BENCHMARKRUNNER_H
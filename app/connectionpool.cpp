@@ -0,0 +1,293 @@
+#include "connectionpool.h"
+
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QRemoteObjectReplica>
+#include <iostream>
+
+#include "logos_api.h"
+#include "logos_api_client.h"
+
+namespace {
+const int kInitialBackoffMs = 250;
+const int kMaxBackoffMs = 10000;
+}
+
+ConnectionPool::ConnectionPool(LogosAPI* logosAPI, QObject* parent)
+    : QObject(parent)
+    , m_logosAPI(logosAPI)
+    , m_healthTimer(new QTimer(this))
+{
+    m_healthTimer->setInterval(2000);
+    connect(m_healthTimer, &QTimer::timeout, this, &ConnectionPool::checkHealth);
+    m_healthTimer->start();
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    // No signals from here: receivers may already be half destroyed.
+    for (const QSharedPointer<Entry>& entry : std::as_const(m_entries)) {
+        if (entry->replica) {
+            entry->replica->disconnect(this);
+            entry->replica->deleteLater();
+        }
+    }
+}
+
+LogosAPIClient* ConnectionPool::client(const QString& moduleName, double* setupMs)
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    if (!entry) {
+        entry.reset(new Entry);
+        m_entries.insert(moduleName, entry);
+    }
+    if (entry->state == State::Connected && entry->client) {
+        return entry->client;
+    }
+    if (entry->state == State::Reconnecting || entry->state == State::Connecting) {
+        // A retry is already scheduled or running; piling more attempts on
+        // top of it is exactly the reconnect storm the backoff avoids.
+        return nullptr;
+    }
+
+    setState(moduleName, *entry, State::Connecting);
+    bool ok = establish(moduleName, *entry);
+    if (m_entries.value(moduleName) != entry) {
+        // Released while the replica was being acquired.
+        return nullptr;
+    }
+    if (!ok) {
+        // Retry on the same backoff as a lost connection; callers until
+        // then get nullptr instead of each starting another attempt.
+        ++entry->failedAttempts;
+        setState(moduleName, *entry, State::Reconnecting);
+        scheduleReconnect(moduleName);
+        return nullptr;
+    }
+    if (setupMs) {
+        *setupMs += entry->setupMs;
+    }
+    entry->everConnected = true;
+    setState(moduleName, *entry, State::Connected);
+    emit replicaChanged(moduleName, entry->replica);
+    return entry->client;
+}
+
+QObject* ConnectionPool::replica(const QString& moduleName, double* setupMs)
+{
+    if (!client(moduleName, setupMs)) {
+        return nullptr;
+    }
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    return entry ? entry->replica.data() : nullptr;
+}
+
+bool ConnectionPool::warmUp(const QString& moduleName)
+{
+    double setupMs = 0.0;
+    bool ok = replica(moduleName, &setupMs) != nullptr;
+    std::cout << "Connection warm-up for " << moduleName.toStdString() << ": "
+              << (ok ? "ok" : "failed") << " (" << setupMs << " ms)" << std::endl;
+    return ok;
+}
+
+void ConnectionPool::release(const QString& moduleName)
+{
+    QSharedPointer<Entry> entry = m_entries.take(moduleName);
+    if (!entry) {
+        return;
+    }
+    if (entry->retryTimer) {
+        entry->retryTimer->stop();
+        entry->retryTimer->deleteLater();
+    }
+    if (entry->replica) {
+        entry->replica->disconnect(this);
+        entry->replica->deleteLater();
+    }
+    emit stateChanged(moduleName, State::Disconnected);
+}
+
+void ConnectionPool::releaseAll()
+{
+    const QStringList modules = m_entries.keys();
+    for (const QString& moduleName : modules) {
+        release(moduleName);
+    }
+}
+
+ConnectionPool::State ConnectionPool::state(const QString& moduleName) const
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    return entry ? entry->state : State::Disconnected;
+}
+
+double ConnectionPool::lastSetupMs(const QString& moduleName) const
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    return entry ? entry->setupMs : 0.0;
+}
+
+int ConnectionPool::reconnectCount(const QString& moduleName) const
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    return entry ? entry->reconnects : 0;
+}
+
+void ConnectionPool::setHealthCheckInterval(int intervalMs)
+{
+    m_healthTimer->setInterval(qMax(100, intervalMs));
+}
+
+QString ConnectionPool::stateName(State state)
+{
+    switch (state) {
+        case State::Disconnected:
+            return "Disconnected";
+        case State::Connecting:
+            return "Connecting";
+        case State::Connected:
+            return "Connected";
+        case State::Reconnecting:
+            return "Reconnecting";
+    }
+    return "Unknown";
+}
+
+bool ConnectionPool::establish(const QString& moduleName, Entry& entry)
+{
+    if (!m_logosAPI) {
+        return false;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    if (!entry.client) {
+        entry.client = m_logosAPI->getClient(moduleName);
+    }
+    if (!entry.client) {
+        std::cout << "ConnectionPool: no client for module " << moduleName.toStdString() << std::endl;
+        return false;
+    }
+    if (!entry.client->isConnected() && !entry.client->reconnect()) {
+        std::cout << "ConnectionPool: client for " << moduleName.toStdString() << " is not connected" << std::endl;
+        return false;
+    }
+
+    if (entry.replica) {
+        entry.replica->disconnect(this);
+        entry.replica->deleteLater();
+    }
+    QObject* replica = entry.client->requestObject(moduleName);
+    if (!replica) {
+        std::cout << "ConnectionPool: failed to acquire replica for " << moduleName.toStdString() << std::endl;
+        return false;
+    }
+    entry.replica = replica;
+
+    if (QRemoteObjectReplica* remote = qobject_cast<QRemoteObjectReplica*>(replica)) {
+        connect(remote, &QRemoteObjectReplica::stateChanged, this,
+                [this, moduleName](QRemoteObjectReplica::State state, QRemoteObjectReplica::State) {
+            if (state == QRemoteObjectReplica::Suspect || state == QRemoteObjectReplica::SignatureMismatch) {
+                markLost(moduleName);
+            }
+        });
+    }
+
+    entry.setupMs = elapsed.nsecsElapsed() / 1e6;
+    return true;
+}
+
+bool ConnectionPool::isHealthy(const Entry& entry) const
+{
+    if (!entry.client || !entry.replica || !entry.client->isConnected()) {
+        return false;
+    }
+    QRemoteObjectReplica* remote = qobject_cast<QRemoteObjectReplica*>(entry.replica.data());
+    return !remote || remote->isReplicaValid();
+}
+
+void ConnectionPool::setState(const QString& moduleName, Entry& entry, State state)
+{
+    if (entry.state == state) {
+        return;
+    }
+    entry.state = state;
+    emit stateChanged(moduleName, state);
+}
+
+void ConnectionPool::checkHealth()
+{
+    const QStringList modules = m_entries.keys();
+    for (const QString& moduleName : modules) {
+        QSharedPointer<Entry> entry = m_entries.value(moduleName);
+        if (entry && entry->state == State::Connected && !isHealthy(*entry)) {
+            markLost(moduleName);
+        }
+    }
+}
+
+void ConnectionPool::markLost(const QString& moduleName)
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    if (!entry || entry->state != State::Connected) {
+        return;
+    }
+    std::cout << "ConnectionPool: lost connection to " << moduleName.toStdString() << std::endl;
+    if (entry->replica) {
+        entry->replica->disconnect(this);
+        entry->replica->deleteLater();
+        entry->replica = nullptr;
+    }
+    setState(moduleName, *entry, State::Reconnecting);
+    emit replicaChanged(moduleName, nullptr);
+    scheduleReconnect(moduleName);
+}
+
+void ConnectionPool::scheduleReconnect(const QString& moduleName)
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    if (!entry) {
+        return;
+    }
+    if (!entry->retryTimer) {
+        entry->retryTimer = new QTimer(this);
+        entry->retryTimer->setSingleShot(true);
+        connect(entry->retryTimer, &QTimer::timeout, this, [this, moduleName]() {
+            attemptReconnect(moduleName);
+        });
+    }
+
+    // +/-20% jitter around the exponential step keeps several viewers that
+    // lost the same host from retrying in lockstep.
+    int backoff = kInitialBackoffMs << qMin(entry->failedAttempts, 10);
+    backoff = qMin(backoff, kMaxBackoffMs);
+    double jitter = 0.8 + 0.4 * QRandomGenerator::global()->generateDouble();
+    entry->retryTimer->start(static_cast<int>(backoff * jitter));
+}
+
+void ConnectionPool::attemptReconnect(const QString& moduleName)
+{
+    QSharedPointer<Entry> entry = m_entries.value(moduleName);
+    if (!entry || entry->state != State::Reconnecting) {
+        return;
+    }
+    bool ok = establish(moduleName, *entry);
+    if (m_entries.value(moduleName) != entry) {
+        return;
+    }
+    if (!ok) {
+        ++entry->failedAttempts;
+        scheduleReconnect(moduleName);
+        return;
+    }
+    entry->failedAttempts = 0;
+    if (entry->everConnected) {
+        ++entry->reconnects;
+    }
+    entry->everConnected = true;
+    setState(moduleName, *entry, State::Connected);
+    emit replicaChanged(moduleName, entry->replica);
+}
@@ -0,0 +1,85 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QPointer>
+#include <QSharedPointer>
+
+class QTimer;
+class LogosAPI;
+class LogosAPIClient;
+
+// Keeps one validated LogosAPIClient and replica per module so calls and
+// subscriptions reuse them instead of setting up a connection each time.
+// A periodic health check notices when the host has gone away and
+// reconnects with exponential backoff and jitter.
+class ConnectionPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class State {
+        Disconnected,
+        Connecting,
+        Connected,
+        Reconnecting
+    };
+    Q_ENUM(State)
+
+    explicit ConnectionPool(LogosAPI* logosAPI, QObject* parent = nullptr);
+    ~ConnectionPool();
+
+    // Returns a connected client, creating it on first use. Time spent
+    // setting up the connection is added to *setupMs when given. Returns
+    // nullptr while a failed connection waits for its next retry.
+    LogosAPIClient* client(const QString& moduleName, double* setupMs = nullptr);
+    QObject* replica(const QString& moduleName, double* setupMs = nullptr);
+
+    // Creates the client and replica ahead of the first call.
+    bool warmUp(const QString& moduleName);
+    void release(const QString& moduleName);
+    void releaseAll();
+
+    State state(const QString& moduleName) const;
+    double lastSetupMs(const QString& moduleName) const;
+    int reconnectCount(const QString& moduleName) const;
+
+    void setHealthCheckInterval(int intervalMs);
+
+    static QString stateName(State state);
+
+signals:
+    void stateChanged(const QString& moduleName, ConnectionPool::State state);
+    void replicaChanged(const QString& moduleName, QObject* replica);
+
+private slots:
+    void checkHealth();
+
+private:
+    struct Entry {
+        LogosAPIClient* client = nullptr;
+        QPointer<QObject> replica;
+        State state = State::Disconnected;
+        double setupMs = 0.0;
+        int failedAttempts = 0;
+        int reconnects = 0;
+        // A retry after a failed first connect is not a reconnect.
+        bool everConnected = false;
+        QTimer* retryTimer = nullptr;
+    };
+
+    bool establish(const QString& moduleName, Entry& entry);
+    bool isHealthy(const Entry& entry) const;
+    void setState(const QString& moduleName, Entry& entry, State state);
+    void markLost(const QString& moduleName);
+    void scheduleReconnect(const QString& moduleName);
+    void attemptReconnect(const QString& moduleName);
+
+    LogosAPI* m_logosAPI;
+    QHash<QString, QSharedPointer<Entry>> m_entries;
+    QTimer* m_healthTimer;
+};
+
+#endif // CONNECTIONPOOL_H
@@ -0,0 +1,204 @@
+#include "eventmetrics.h"
+
+#include <QDateTime>
+#include <cmath>
+
+double EventTypeStats::intervalStddevMs() const
+{
+    return intervals > 1 ? std::sqrt(intervalM2 / (intervals - 1)) : 0.0;
+}
+
+double EventTypeStats::rate(int windowSeconds, double nowMs) const
+{
+    if (secondCounts.isEmpty() || windowSeconds <= 0) {
+        return 0.0;
+    }
+    windowSeconds = qMin(windowSeconds, kRateSlots - 1);
+    const qint64 nowSecond = static_cast<qint64>(std::floor(nowMs / 1000.0));
+    quint64 events = 0;
+    for (qint64 second = nowSecond - windowSeconds; second < nowSecond; ++second) {
+        const int slot = static_cast<int>(second % kRateSlots);
+        if (second >= 0 && secondIndex.at(slot) == second) {
+            events += secondCounts.at(slot);
+        }
+    }
+    return static_cast<double>(events) / windowSeconds;
+}
+
+EventMetrics::EventMetrics()
+{
+    m_total.name = "(all)";
+    setEmitTimestampPath("data[0].timestamp");
+}
+
+bool EventMetrics::setEmitTimestampPath(const QString& path)
+{
+    QVector<EventQuery::PathStep> steps;
+    const QString trimmed = path.trimmed();
+    if (!trimmed.isEmpty() && !EventQuery::parsePath(trimmed, &steps)) {
+        return false;
+    }
+    m_emitPath = trimmed;
+    m_emitSteps = steps;
+
+    auto resetEmit = [](EventTypeStats* stats) {
+        stats->emitLatency.clear();
+        stats->transitJitterMs = 0.0;
+        stats->lastTransitMs = 0.0;
+        stats->missingEmitTimestamp = 0;
+        stats->clockSkewed = 0;
+    };
+    for (auto it = m_stats.begin(); it != m_stats.end(); ++it) {
+        resetEmit(&it.value());
+    }
+    resetEmit(&m_total);
+    return true;
+}
+
+void EventMetrics::ensure(const QString& name)
+{
+    if (m_stats.contains(name)) {
+        return;
+    }
+    EventTypeStats stats;
+    stats.name = name;
+    m_stats.insert(name, stats);
+    m_order.append(name);
+}
+
+void EventMetrics::record(const QString& name, qint64 arrivalWallMs, double receivedMs, double formattedMs,
+                          double displayedMs, const QVariantList& payload)
+{
+    ensure(name);
+    EventTypeStats& stats = m_stats[name];
+
+    bool hasTransit = false;
+    double transitMs = 0.0;
+    if (!m_emitSteps.isEmpty()) {
+        double emitMs = 0.0;
+        if (toEpochMs(EventStore::valueAtPath(payload, m_emitSteps), &emitMs)) {
+            transitMs = arrivalWallMs - emitMs;
+            hasTransit = true;
+            // Stamps and arrival are whole milliseconds at best; only call it
+            // skew when the emit time is clearly in the future.
+            if (transitMs < -1.0) {
+                ++stats.clockSkewed;
+                ++m_total.clockSkewed;
+            }
+        } else {
+            ++stats.missingEmitTimestamp;
+            ++m_total.missingEmitTimestamp;
+        }
+    }
+
+    recordInto(&stats, receivedMs, formattedMs, displayedMs, hasTransit, transitMs);
+    recordInto(&m_total, receivedMs, formattedMs, displayedMs, hasTransit, transitMs);
+}
+
+void EventMetrics::recordInto(EventTypeStats* stats, double receivedMs, double formattedMs, double displayedMs,
+                              bool hasTransit, double transitMs)
+{
+    if (stats->count == 0) {
+        stats->firstMs = receivedMs;
+    } else {
+        // Batches from the pipeline keep arrival order, so this is the gap
+        // to the previous event of the same name.
+        const double interval = qMax(0.0, receivedMs - stats->lastMs);
+        ++stats->intervals;
+        const double delta = interval - stats->intervalMeanMs;
+        stats->intervalMeanMs += delta / stats->intervals;
+        stats->intervalM2 += delta * (interval - stats->intervalMeanMs);
+    }
+    ++stats->count;
+    stats->lastMs = qMax(stats->lastMs, receivedMs);
+
+    if (stats->secondCounts.isEmpty()) {
+        stats->secondCounts.fill(0, EventTypeStats::kRateSlots);
+        stats->secondIndex.fill(-1, EventTypeStats::kRateSlots);
+    }
+    const qint64 second = static_cast<qint64>(std::floor(receivedMs / 1000.0));
+    const int slot = static_cast<int>(second % EventTypeStats::kRateSlots);
+    if (stats->secondIndex.at(slot) != second) {
+        stats->secondIndex[slot] = second;
+        stats->secondCounts[slot] = 0;
+    }
+    ++stats->secondCounts[slot];
+
+    if (hasTransit) {
+        if (stats->emitLatency.count > 0) {
+            stats->transitJitterMs += (std::fabs(transitMs - stats->lastTransitMs) - stats->transitJitterMs) / 16.0;
+        }
+        stats->emitLatency.add(transitMs);
+        stats->lastTransitMs = transitMs;
+    }
+    if (formattedMs > 0.0) {
+        stats->queueLatency.add(formattedMs - receivedMs);
+        stats->displayLatency.add(displayedMs - formattedMs);
+        stats->viewerLatency.add(displayedMs - receivedMs);
+    }
+}
+
+void EventMetrics::recordLogAppend(double ms)
+{
+    m_logAppend.add(ms);
+}
+
+void EventMetrics::clear()
+{
+    m_order.clear();
+    m_stats.clear();
+    const QString path = m_emitPath;
+    m_total = EventTypeStats();
+    m_total.name = "(all)";
+    m_logAppend.clear();
+    setEmitTimestampPath(path);
+}
+
+const EventTypeStats* EventMetrics::stats(const QString& name) const
+{
+    auto it = m_stats.constFind(name);
+    return it == m_stats.constEnd() ? nullptr : &it.value();
+}
+
+bool EventMetrics::toEpochMs(const QVariant& value, double* epochMs)
+{
+    if (!value.isValid() || value.isNull()) {
+        return false;
+    }
+    if (value.typeId() == QMetaType::QDateTime) {
+        const QDateTime dateTime = value.toDateTime();
+        if (!dateTime.isValid()) {
+            return false;
+        }
+        *epochMs = static_cast<double>(dateTime.toMSecsSinceEpoch());
+        return true;
+    }
+
+    bool ok = false;
+    double number = value.toDouble(&ok);
+    if (!ok && value.typeId() == QMetaType::QString) {
+        const QDateTime dateTime = QDateTime::fromString(value.toString().trimmed(), Qt::ISODateWithMs);
+        if (!dateTime.isValid()) {
+            return false;
+        }
+        *epochMs = static_cast<double>(dateTime.toMSecsSinceEpoch());
+        return true;
+    }
+    if (!ok || number <= 0.0) {
+        return false;
+    }
+
+    // 1e9 s, 1e12 ms, 1e15 us and 1e18 ns are all around 2001-2033.
+    if (number >= 1e17) {
+        number /= 1e6;
+    } else if (number >= 1e14) {
+        number /= 1e3;
+    } else if (number < 1e11) {
+        if (number < 1e8) {
+            return false;
+        }
+        number *= 1e3;
+    }
+    *epochMs = number;
+    return true;
+}
@@ -0,0 +1,103 @@
+#ifndef EVENTMETRICS_H
+#define EVENTMETRICS_H
+
+#include "eventstore.h"
+#include "latencystats.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Arrival statistics for one event name. Times are on the MonotonicClock
+// timeline except the emit-to-receive latency, which compares the wall clock
+// stamp in the payload with the wall clock at arrival.
+struct EventTypeStats
+{
+    static const int kRateSlots = 61;
+
+    QString name;
+    quint64 count = 0;
+    double firstMs = 0.0;
+    double lastMs = 0.0;
+
+    // Inter-arrival times (Welford); their standard deviation is the jitter.
+    quint64 intervals = 0;
+    double intervalMeanMs = 0.0;
+    double intervalM2 = 0.0;
+
+    // Payload emit timestamp -> arrival in the subscription callback.
+    LatencyHistogram emitLatency;
+    // RFC 3550 style smoothed variation of the emit-to-receive transit time.
+    double transitJitterMs = 0.0;
+    double lastTransitMs = 0.0;
+    quint64 missingEmitTimestamp = 0;
+    // Emit timestamps later than the arrival by more than a millisecond.
+    quint64 clockSkewed = 0;
+
+    // Arrival -> formatted by the pipeline worker.
+    LatencyHistogram queueLatency;
+    // Formatted -> appended to the event log.
+    LatencyHistogram displayLatency;
+    // Arrival -> appended to the event log; the two above end to end.
+    LatencyHistogram viewerLatency;
+
+    // Arrivals per second over the last minute plus the current second,
+    // slot = second % kRateSlots.
+    QVector<quint32> secondCounts;
+    QVector<qint64> secondIndex;
+
+    double intervalStddevMs() const;
+    // Events per second over the last windowSeconds complete seconds.
+    double rate(int windowSeconds, double nowMs) const;
+};
+
+// Per-event-name rates, jitter and latency for everything the viewer shows,
+// split by stage so lag can be pinned on the module and transport (emit to
+// receive), the formatting worker, or the event log.
+class EventMetrics
+{
+public:
+    EventMetrics();
+
+    // Path to the emit timestamp in the payload, e.g. data[0].timestamp.
+    // Empty turns emit-to-receive latency off. Returns false if the path
+    // does not parse. Changing it resets the emit latency of every event.
+    bool setEmitTimestampPath(const QString& path);
+    QString emitTimestampPath() const { return m_emitPath; }
+
+    // Adds a row for an event before its first arrival.
+    void ensure(const QString& name);
+    // payload should already be normalized the way EventStore stores it.
+    void record(const QString& name, qint64 arrivalWallMs, double receivedMs, double formattedMs,
+                double displayedMs, const QVariantList& payload);
+    // Time spent appending one batch of events to the log.
+    void recordLogAppend(double ms);
+    void clear();
+
+    // In order of first appearance.
+    QStringList names() const { return m_order; }
+    const EventTypeStats* stats(const QString& name) const;
+    // Every event name together.
+    const EventTypeStats& total() const { return m_total; }
+    const LatencyHistogram& logAppend() const { return m_logAppend; }
+
+    // Accepts epoch seconds, milliseconds, microseconds or nanoseconds
+    // (told apart by magnitude), numeric strings, ISO 8601 strings and
+    // QDateTime values.
+    static bool toEpochMs(const QVariant& value, double* epochMs);
+
+private:
+    void recordInto(EventTypeStats* stats, double receivedMs, double formattedMs, double displayedMs,
+                    bool hasTransit, double transitMs);
+
+    QString m_emitPath;
+    QVector<EventQuery::PathStep> m_emitSteps;
+    QStringList m_order;
+    QHash<QString, EventTypeStats> m_stats;
+    EventTypeStats m_total;
+    LatencyHistogram m_logAppend;
+};
+
+#endif // EVENTMETRICS_H
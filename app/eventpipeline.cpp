@@ -0,0 +1,214 @@
+#include "eventpipeline.h"
+#include "eventstore.h"
+#include "monotonicclock.h"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+
+namespace {
+// Raw events the worker formats per lock round trip.
+const int kWorkerChunk = 512;
+// Formatted events handed to the GUI per frame. Anything beyond this stays
+// queued and counts against capacity, which is what pushes back on a
+// producer that outruns the GUI.
+const int kMaxBatch = 2000;
+}
+
+EventPipeline::EventPipeline(QObject* parent)
+    : QObject(parent)
+    , m_worker(nullptr)
+    , m_frameTimer(new QTimer(this))
+{
+    m_worker = QThread::create([this]() { runWorker(); });
+    m_worker->setObjectName("EventPipelineWorker");
+    m_worker->start();
+
+    m_frameTimer->setInterval(16);
+    connect(m_frameTimer, &QTimer::timeout, this, &EventPipeline::flush);
+    m_frameTimer->start();
+}
+
+EventPipeline::~EventPipeline()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_stopping = true;
+        m_inputReady.wakeAll();
+    }
+    m_worker->wait();
+    delete m_worker;
+}
+
+void EventPipeline::submit(const QString& name, const QVariantList& data)
+{
+    PipelineEvent event;
+    event.name = name;
+    event.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    event.receivedMs = MonotonicClock::nowMs();
+    event.data = data;
+
+    ++m_received;
+    const int capacity = m_capacity.load();
+    const OverflowPolicy policy = m_policy.load();
+
+    QMutexLocker locker(&m_mutex);
+    const int pending = pendingLocked();
+    if (policy == OverflowPolicy::Sample && pending >= capacity / 2) {
+        const int every = qMax(1, m_sampleEvery.load());
+        if (++m_sampleCounter % every != 0 || pending >= capacity) {
+            ++m_dropped;
+            return;
+        }
+    } else if (pending >= capacity) {
+        if (policy == OverflowPolicy::DropNewest) {
+            ++m_dropped;
+            return;
+        }
+        // Formatted events are older than the ones the worker is on, and
+        // those are older than the ones still waiting, so they go first.
+        if (!m_output.isEmpty()) {
+            m_output.removeFirst();
+        } else if (m_inFlightDrops < m_inFlight) {
+            ++m_inFlightDrops;
+        } else if (!m_input.isEmpty()) {
+            m_input.removeFirst();
+        }
+        ++m_dropped;
+    }
+
+    m_input.enqueue(event);
+    if (m_input.size() == 1) {
+        m_inputReady.wakeOne();
+    }
+}
+
+void EventPipeline::setOverflowPolicy(OverflowPolicy policy)
+{
+    m_policy = policy;
+}
+
+void EventPipeline::setCapacity(int capacity)
+{
+    m_capacity = qMax(1, capacity);
+}
+
+void EventPipeline::setSampleEvery(int sampleEvery)
+{
+    m_sampleEvery = qMax(1, sampleEvery);
+}
+
+void EventPipeline::setFrameInterval(int ms)
+{
+    m_frameTimer->setInterval(qMax(1, ms));
+}
+
+int EventPipeline::pendingCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return pendingLocked();
+}
+
+int EventPipeline::pendingLocked() const
+{
+    return m_input.size() + m_output.size() + m_inFlight - m_inFlightDrops;
+}
+
+void EventPipeline::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_input.clear();
+    m_output.clear();
+    m_inFlight = 0;
+    m_inFlightDrops = 0;
+    m_sampleCounter = 0;
+    ++m_generation;
+    m_received = 0;
+    m_dropped = 0;
+    m_delivered = 0;
+}
+
+QString EventPipeline::formatEvent(const QString& name, qint64 timestampMs, const QVariantList& data)
+{
+    QJsonObject eventObj;
+    eventObj["event"] = name;
+    eventObj["timestamp"] = QDateTime::fromMSecsSinceEpoch(timestampMs).toString(Qt::ISODate);
+
+    QJsonArray dataArray;
+    for (const QVariant& v : data) {
+        dataArray.append(QJsonValue::fromVariant(v));
+    }
+    eventObj["data"] = dataArray;
+
+    return QString::fromUtf8(QJsonDocument(eventObj).toJson(QJsonDocument::Indented));
+}
+
+QString EventPipeline::policyName(OverflowPolicy policy)
+{
+    switch (policy) {
+        case OverflowPolicy::DropNewest: return "drop newest";
+        case OverflowPolicy::DropOldest: return "drop oldest";
+        case OverflowPolicy::Sample: return "sample";
+    }
+    return QString();
+}
+
+void EventPipeline::runWorker()
+{
+    QMutexLocker locker(&m_mutex);
+    while (!m_stopping) {
+        if (m_input.isEmpty()) {
+            m_inputReady.wait(&m_mutex);
+            continue;
+        }
+
+        const quint64 generation = m_generation;
+        QVector<PipelineEvent> chunk;
+        const int count = qMin(kWorkerChunk, static_cast<int>(m_input.size()));
+        chunk.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            chunk.append(m_input.dequeue());
+        }
+        m_inFlight = count;
+
+        locker.unlock();
+        for (PipelineEvent& event : chunk) {
+            event.text = formatEvent(event.name, event.timestampMs, event.data);
+            event.data = EventStore::normalizePayload(event.data);
+            event.formattedMs = MonotonicClock::nowMs();
+        }
+        locker.relock();
+
+        // A clear() while the chunk was being formatted discards it.
+        if (generation == m_generation) {
+            chunk.remove(0, m_inFlightDrops);
+            m_output.append(chunk);
+        }
+        m_inFlight = 0;
+        m_inFlightDrops = 0;
+    }
+}
+
+void EventPipeline::flush()
+{
+    QVector<PipelineEvent> batch;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_output.isEmpty()) {
+            return;
+        }
+        if (m_output.size() <= kMaxBatch) {
+            batch.swap(m_output);
+        } else {
+            batch = m_output.mid(0, kMaxBatch);
+            m_output.remove(0, kMaxBatch);
+        }
+    }
+
+    m_delivered += batch.size();
+    emit batchReady(batch);
+}
@@ -0,0 +1,108 @@
+#ifndef EVENTPIPELINE_H
+#define EVENTPIPELINE_H
+
+#include <QObject>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+
+class QThread;
+class QTimer;
+
+struct PipelineEvent
+{
+    QString name;
+    qint64 timestampMs = 0;
+    // Arrival, and the moment the worker finished formatting the event, on
+    // the MonotonicClock timeline.
+    double receivedMs = 0.0;
+    double formattedMs = 0.0;
+    // Raw on submit; once the worker is done, decoded the way EventStore
+    // keeps payloads, so the GUI thread only has to append it.
+    QVariantList data;
+    QString text;
+};
+
+// Moves event formatting off the GUI thread. submit() only queues the raw
+// event; a worker thread converts it to JSON text and decodes its payload
+// for the event store, and a frame timer on the GUI thread hands everything
+// formatted since the last frame to batchReady() in one go. Events in the
+// pipeline, including those being formatted, are bounded by capacity; past
+// that the overflow policy decides what is dropped.
+class EventPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class OverflowPolicy {
+        DropNewest,
+        DropOldest,
+        Sample
+    };
+    Q_ENUM(OverflowPolicy)
+
+    explicit EventPipeline(QObject* parent = nullptr);
+    ~EventPipeline();
+
+    // Thread-safe; may be called from any thread.
+    void submit(const QString& name, const QVariantList& data);
+
+    void setOverflowPolicy(OverflowPolicy policy);
+    OverflowPolicy overflowPolicy() const { return m_policy.load(); }
+    void setCapacity(int capacity);
+    int capacity() const { return m_capacity.load(); }
+    // With the Sample policy, once the pipeline is half full only one in
+    // every sampleEvery events is kept.
+    void setSampleEvery(int sampleEvery);
+    void setFrameInterval(int ms);
+
+    quint64 receivedCount() const { return m_received.load(); }
+    quint64 droppedCount() const { return m_dropped.load(); }
+    quint64 deliveredCount() const { return m_delivered.load(); }
+    int pendingCount() const;
+
+    // Drops everything queued and resets the counters.
+    void clear();
+
+    static QString formatEvent(const QString& name, qint64 timestampMs, const QVariantList& data);
+    static QString policyName(OverflowPolicy policy);
+
+signals:
+    void batchReady(const QVector<PipelineEvent>& batch);
+
+private:
+    void runWorker();
+    void flush();
+    // Queued, in flight and formatted events; call with m_mutex held.
+    int pendingLocked() const;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_inputReady;
+    QQueue<PipelineEvent> m_input;
+    QVector<PipelineEvent> m_output;
+    bool m_stopping = false;
+    quint64 m_generation = 0;
+    // Events the worker has taken off m_input and is formatting. They still
+    // count against capacity; m_inFlightDrops of them, from the oldest, are
+    // discarded when the worker hands the chunk back.
+    int m_inFlight = 0;
+    int m_inFlightDrops = 0;
+
+    QThread* m_worker;
+    QTimer* m_frameTimer;
+
+    std::atomic<OverflowPolicy> m_policy{OverflowPolicy::DropOldest};
+    std::atomic<int> m_capacity{100000};
+    std::atomic<int> m_sampleEvery{10};
+    quint64 m_sampleCounter = 0;
+
+    std::atomic<quint64> m_received{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_delivered{0};
+};
+
+#endif // EVENTPIPELINE_H
@@ -0,0 +1,137 @@
+#include "eventquerypanel.h"
+#include "eventstore.h"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace {
+const int kMaxRows = 1000;
+}
+
+EventQueryPanel::EventQueryPanel(const EventStore* store, QWidget* parent)
+    : QWidget(parent)
+    , m_store(store)
+{
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(8, 8, 8, 8);
+    layout->setSpacing(6);
+
+    QHBoxLayout* inputLayout = new QHBoxLayout();
+    m_queryInput = new QLineEdit(this);
+    m_queryInput->setPlaceholderText("name = transfer and data[0].amount > 1000 in the last 5m  (add \"group by name\" for counts)");
+    m_queryInput->setStyleSheet(
+        "QLineEdit {"
+        "  padding: 6px 8px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "}"
+        "QLineEdit:focus {"
+        "  border: 1px solid #5a9;"
+        "}"
+    );
+    connect(m_queryInput, &QLineEdit::returnPressed, this, &EventQueryPanel::runQuery);
+    inputLayout->addWidget(m_queryInput);
+
+    QPushButton* runButton = new QPushButton("Query", this);
+    runButton->setStyleSheet(
+        "QPushButton {"
+        "  background-color: #5a9;"
+        "  color: #ffffff;"
+        "  border: none;"
+        "  padding: 6px 14px;"
+        "  border-radius: 4px;"
+        "  font-weight: 600;"
+        "}"
+        "QPushButton:hover { background-color: #6bb; }"
+    );
+    connect(runButton, &QPushButton::clicked, this, &EventQueryPanel::runQuery);
+    inputLayout->addWidget(runButton);
+    layout->addLayout(inputLayout);
+
+    m_statusLabel = new QLabel(this);
+    m_statusLabel->setStyleSheet("color: #888; font-size: 11px;");
+    layout->addWidget(m_statusLabel);
+
+    m_results = new QTreeWidget(this);
+    m_results->setRootIsDecorated(false);
+    m_results->setUniformRowHeights(true);
+    m_results->header()->setStretchLastSection(true);
+    m_results->setStyleSheet(
+        "QTreeWidget {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 12px;"
+        "  border: 1px solid #3d3d3d;"
+        "  background-color: #252525;"
+        "  color: #e0e0e0;"
+        "}"
+    );
+    layout->addWidget(m_results);
+}
+
+void EventQueryPanel::runQuery()
+{
+    QString error;
+    EventQuery query = EventQuery::parse(m_queryInput->text(), &error);
+    if (!error.isEmpty()) {
+        m_statusLabel->setText(QString("<span style='color: #ff6b6b;'>%1</span>").arg(error.toHtmlEscaped()));
+        return;
+    }
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QElapsedTimer timer;
+    timer.start();
+    m_results->clear();
+
+    if (query.groupByName) {
+        const QVector<EventGroupStats> groups = m_store->groupByName(query, nowMs);
+        const double elapsedMs = timer.nsecsElapsed() / 1e6;
+        m_results->setHeaderLabels({"Event", "Count", "Rate /s", "First", "Last"});
+        for (const EventGroupStats& stats : groups) {
+            QTreeWidgetItem* item = new QTreeWidgetItem(m_results);
+            item->setText(0, stats.name);
+            item->setText(1, QString::number(stats.count));
+            item->setText(2, QString::number(stats.ratePerSecond, 'f', 2));
+            item->setText(3, QDateTime::fromMSecsSinceEpoch(stats.firstMs).toString("HH:mm:ss.zzz"));
+            item->setText(4, QDateTime::fromMSecsSinceEpoch(stats.lastMs).toString("HH:mm:ss.zzz"));
+        }
+        m_statusLabel->setText(QString("%1 event names over %2 stored events in %3 ms")
+            .arg(groups.size())
+            .arg(m_store->size())
+            .arg(elapsedMs, 0, 'f', 2));
+        return;
+    }
+
+    int total = 0;
+    const QVector<int> rows = m_store->query(query, nowMs, kMaxRows, &total);
+    const double elapsedMs = timer.nsecsElapsed() / 1e6;
+
+    m_results->setHeaderLabels({"Time", "Event", "Data"});
+    QList<QTreeWidgetItem*> items;
+    items.reserve(rows.size());
+    for (int row : rows) {
+        QTreeWidgetItem* item = new QTreeWidgetItem();
+        item->setText(0, QDateTime::fromMSecsSinceEpoch(m_store->timestampAt(row)).toString("HH:mm:ss.zzz"));
+        item->setText(1, m_store->nameAt(row));
+        item->setText(2, QString::fromUtf8(QJsonDocument(QJsonArray::fromVariantList(m_store->dataAt(row)))
+            .toJson(QJsonDocument::Compact)));
+        items.append(item);
+    }
+    m_results->addTopLevelItems(items);
+    m_statusLabel->setText(QString("%1 matches (showing %2, newest first) of %3 stored events in %4 ms")
+        .arg(total)
+        .arg(rows.size())
+        .arg(m_store->size())
+        .arg(elapsedMs, 0, 'f', 2));
+}
@@ -0,0 +1,29 @@
+#ifndef EVENTQUERYPANEL_H
+#define EVENTQUERYPANEL_H
+
+#include <QWidget>
+
+class EventStore;
+class QLineEdit;
+class QLabel;
+class QTreeWidget;
+
+// Query box and result table over the viewer's EventStore.
+class EventQueryPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit EventQueryPanel(const EventStore* store, QWidget* parent = nullptr);
+
+public slots:
+    void runQuery();
+
+private:
+    const EventStore* m_store;
+    QLineEdit* m_queryInput;
+    QLabel* m_statusLabel;
+    QTreeWidget* m_results;
+};
+
+#endif // EVENTQUERYPANEL_H
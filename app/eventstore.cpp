@@ -0,0 +1,548 @@
+#include "eventstore.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <algorithm>
+
+namespace {
+
+struct Token
+{
+    QString text;
+    bool quoted = false;
+};
+
+bool isOperatorChar(QChar c)
+{
+    return c == '=' || c == '!' || c == '<' || c == '>';
+}
+
+QVector<Token> tokenize(const QString& text, QString* error)
+{
+    QVector<Token> tokens;
+    int i = 0;
+    while (i < text.size()) {
+        const QChar c = text.at(i);
+        if (c.isSpace()) {
+            ++i;
+        } else if (c == '"' || c == '\'') {
+            int end = text.indexOf(c, i + 1);
+            if (end < 0) {
+                if (error) {
+                    *error = "Unterminated string";
+                }
+                return QVector<Token>();
+            }
+            tokens.append({text.mid(i + 1, end - i - 1), true});
+            i = end + 1;
+        } else if (isOperatorChar(c)) {
+            int start = i;
+            while (i < text.size() && isOperatorChar(text.at(i)) && i - start < 2) {
+                ++i;
+            }
+            tokens.append({text.mid(start, i - start), false});
+        } else {
+            int start = i;
+            while (i < text.size() && !text.at(i).isSpace() && !isOperatorChar(text.at(i))
+                   && text.at(i) != '"' && text.at(i) != '\'') {
+                ++i;
+            }
+            tokens.append({text.mid(start, i - start), false});
+        }
+    }
+    return tokens;
+}
+
+bool parseOperator(const QString& text, EventQuery::Predicate::Op* op)
+{
+    using Op = EventQuery::Predicate::Op;
+    static const QHash<QString, Op> operators = {
+        {"=", Op::Equal}, {"==", Op::Equal}, {"!=", Op::NotEqual},
+        {"<", Op::Less}, {"<=", Op::LessEqual}, {">", Op::Greater}, {">=", Op::GreaterEqual},
+        {"contains", Op::Contains}
+    };
+    auto it = operators.constFind(text.toLower());
+    if (it == operators.constEnd()) {
+        return false;
+    }
+    *op = it.value();
+    return true;
+}
+
+// "5m", "5 minutes", "250ms" -> milliseconds; consumes one or two tokens.
+bool parseDuration(const QVector<Token>& tokens, int* pos, qint64* durationMs)
+{
+    if (*pos >= tokens.size()) {
+        return false;
+    }
+    QString text = tokens.at(*pos).text.toLower();
+    int split = 0;
+    while (split < text.size() && (text.at(split).isDigit() || text.at(split) == '.')) {
+        ++split;
+    }
+    bool ok = false;
+    double amount = text.left(split).toDouble(&ok);
+    if (!ok) {
+        return false;
+    }
+    QString unit = text.mid(split);
+    ++*pos;
+    if (unit.isEmpty() && *pos < tokens.size()) {
+        unit = tokens.at(*pos).text.toLower();
+        ++*pos;
+    }
+
+    double scale = 0.0;
+    if (unit == "ms" || unit.startsWith("milli")) {
+        scale = 1.0;
+    } else if (unit == "s" || unit.startsWith("sec")) {
+        scale = 1000.0;
+    } else if (unit == "m" || unit.startsWith("min")) {
+        scale = 60.0 * 1000.0;
+    } else if (unit == "h" || unit.startsWith("hour")) {
+        scale = 60.0 * 60.0 * 1000.0;
+    } else {
+        return false;
+    }
+    *durationMs = static_cast<qint64>(amount * scale);
+    return true;
+}
+
+QVariant literalValue(const Token& token)
+{
+    if (token.quoted) {
+        return token.text;
+    }
+    bool ok = false;
+    double number = token.text.toDouble(&ok);
+    if (ok) {
+        return number;
+    }
+    if (token.text.compare("true", Qt::CaseInsensitive) == 0) {
+        return true;
+    }
+    if (token.text.compare("false", Qt::CaseInsensitive) == 0) {
+        return false;
+    }
+    return token.text;
+}
+
+// JSON containers become QVariantMap/QVariantList, and strings holding a JSON
+// object or array are decoded, so paths can reach into them.
+QVariant normalizeValue(const QVariant& value)
+{
+    switch (value.typeId()) {
+        case QMetaType::QJsonObject:
+            return value.toJsonObject().toVariantMap();
+        case QMetaType::QJsonArray:
+            return value.toJsonArray().toVariantList();
+        case QMetaType::QJsonValue:
+            return normalizeValue(value.toJsonValue().toVariant());
+        case QMetaType::QString: {
+            const QString text = value.toString();
+            int first = 0;
+            while (first < text.size() && text.at(first).isSpace()) {
+                ++first;
+            }
+            if (first >= text.size() || (text.at(first) != '{' && text.at(first) != '[')) {
+                return value;
+            }
+            QJsonParseError parseError;
+            QJsonDocument doc = QJsonDocument::fromJson(text.toUtf8(), &parseError);
+            if (parseError.error != QJsonParseError::NoError) {
+                return value;
+            }
+            return doc.isObject() ? QVariant(doc.object().toVariantMap()) : QVariant(doc.array().toVariantList());
+        }
+        default:
+            return value;
+    }
+}
+
+bool comparePredicate(const QVariant& actual, const EventQuery::Predicate& predicate)
+{
+    using Op = EventQuery::Predicate::Op;
+    if (!actual.isValid()) {
+        return predicate.op == Op::NotEqual;
+    }
+    if (predicate.op == Op::Contains) {
+        return actual.toString().contains(predicate.value.toString(), Qt::CaseInsensitive);
+    }
+
+    int order = 0;
+    bool actualNumeric = false;
+    const double actualNumber = actual.toDouble(&actualNumeric);
+    if (predicate.value.typeId() == QMetaType::Double && actualNumeric) {
+        const double expected = predicate.value.toDouble();
+        order = actualNumber < expected ? -1 : (actualNumber > expected ? 1 : 0);
+    } else if (predicate.value.typeId() == QMetaType::Bool) {
+        order = actual.toBool() == predicate.value.toBool() ? 0 : 1;
+    } else {
+        order = QString::compare(actual.toString(), predicate.value.toString());
+    }
+
+    switch (predicate.op) {
+        case Op::Equal: return order == 0;
+        case Op::NotEqual: return order != 0;
+        case Op::Less: return order < 0;
+        case Op::LessEqual: return order <= 0;
+        case Op::Greater: return order > 0;
+        case Op::GreaterEqual: return order >= 0;
+        case Op::Contains: break;
+    }
+    return false;
+}
+
+}
+
+EventQuery EventQuery::parse(const QString& text, QString* error)
+{
+    EventQuery query;
+    QString tokenError;
+    const QVector<Token> tokens = tokenize(text, &tokenError);
+    if (!tokenError.isEmpty()) {
+        if (error) {
+            *error = tokenError;
+        }
+        return EventQuery();
+    }
+
+    auto fail = [error](const QString& message) {
+        if (error) {
+            *error = message;
+        }
+        return EventQuery();
+    };
+    auto keyword = [&tokens](int pos, const char* word) {
+        return pos < tokens.size() && !tokens.at(pos).quoted
+            && tokens.at(pos).text.compare(QLatin1String(word), Qt::CaseInsensitive) == 0;
+    };
+
+    int pos = 0;
+    while (pos < tokens.size()) {
+        if (keyword(pos, "and")) {
+            ++pos;
+        } else if (keyword(pos, "group")) {
+            if (!keyword(pos + 1, "by") || !keyword(pos + 2, "name")) {
+                return fail("Only \"group by name\" is supported");
+            }
+            query.groupByName = true;
+            pos += 3;
+        } else if (keyword(pos, "name")) {
+            Predicate::Op op;
+            if (pos + 2 >= tokens.size()) {
+                return fail("Expected: name = <event>");
+            }
+            if (!parseOperator(tokens.at(pos + 1).text, &op) || op != Predicate::Op::Equal) {
+                return fail("Only name = <event> is supported");
+            }
+            query.eventName = tokens.at(pos + 2).text;
+            pos += 3;
+        } else if (keyword(pos, "in") || keyword(pos, "last") || keyword(pos, "since")) {
+            if (keyword(pos, "in")) {
+                ++pos;
+                if (keyword(pos, "the")) {
+                    ++pos;
+                }
+                if (!keyword(pos, "last")) {
+                    return fail("Expected: in the last <duration>");
+                }
+            }
+            ++pos;
+            if (!parseDuration(tokens, &pos, &query.windowMs)) {
+                return fail("Expected a duration such as 30s, 5m or 2 hours");
+            }
+        } else if (tokens.at(pos).text.startsWith("data", Qt::CaseInsensitive) && !tokens.at(pos).quoted) {
+            if (pos + 2 >= tokens.size()) {
+                return fail(QString("Incomplete condition on %1").arg(tokens.at(pos).text));
+            }
+            Predicate predicate;
+            predicate.path = tokens.at(pos).text;
+            if (!parsePath(predicate.path, &predicate.steps)) {
+                return fail(QString("Invalid path: %1").arg(predicate.path));
+            }
+            if (!parseOperator(tokens.at(pos + 1).text, &predicate.op)) {
+                return fail(QString("Unknown operator: %1").arg(tokens.at(pos + 1).text));
+            }
+            predicate.value = literalValue(tokens.at(pos + 2));
+            query.predicates.append(predicate);
+            pos += 3;
+        } else {
+            return fail(QString("Unexpected \"%1\"").arg(tokens.at(pos).text));
+        }
+    }
+    return query;
+}
+
+bool EventQuery::parsePath(const QString& path, QVector<PathStep>* steps)
+{
+    steps->clear();
+    if (!path.startsWith("data", Qt::CaseInsensitive)) {
+        return false;
+    }
+    int i = 4;
+    while (i < path.size()) {
+        if (path.at(i) == '[') {
+            int end = path.indexOf(']', i);
+            bool ok = false;
+            int index = end > i ? path.mid(i + 1, end - i - 1).toInt(&ok) : -1;
+            if (!ok || index < 0) {
+                return false;
+            }
+            PathStep step;
+            step.index = index;
+            steps->append(step);
+            i = end + 1;
+        } else if (path.at(i) == '.') {
+            int end = i + 1;
+            while (end < path.size() && path.at(end) != '.' && path.at(end) != '[') {
+                ++end;
+            }
+            if (end == i + 1) {
+                return false;
+            }
+            PathStep step;
+            step.key = path.mid(i + 1, end - i - 1);
+            steps->append(step);
+            i = end;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+EventStore::EventStore(int capacity)
+    : m_capacity(qMax(2, (capacity + kChunkRows - 1) / kChunkRows) * kChunkRows)
+    , m_size(0)
+    , m_firstSequence(0)
+    , m_lastTimestampMs(0)
+{
+}
+
+QVariantList EventStore::normalizePayload(const QVariantList& data)
+{
+    QVariantList parsed;
+    parsed.reserve(data.size());
+    for (const QVariant& value : data) {
+        parsed.append(normalizeValue(value));
+    }
+    return parsed;
+}
+
+void EventStore::append(const QString& name, qint64 timestampMs, const QVariantList& data)
+{
+    appendNormalized(name, timestampMs, normalizePayload(data));
+}
+
+void EventStore::appendNormalized(const QString& name, qint64 timestampMs, const QVariantList& data)
+{
+    if (m_size >= m_capacity) {
+        evictOldest();
+    }
+
+    int nameId = m_nameIds.value(name, -1);
+    if (nameId < 0) {
+        nameId = m_names.size();
+        m_names.append(name);
+        m_nameIds.insert(name, nameId);
+        m_sequencesByName.append(QVector<qint64>());
+    }
+
+    // Keep the time column sorted even if the wall clock steps back.
+    if (m_size > 0) {
+        timestampMs = qMax(timestampMs, m_lastTimestampMs);
+    }
+    m_lastTimestampMs = timestampMs;
+
+    if (m_size % kChunkRows == 0) {
+        Chunk chunk;
+        chunk.nameColumn.reserve(kChunkRows);
+        chunk.timeColumn.reserve(kChunkRows);
+        chunk.dataColumn.reserve(kChunkRows);
+        m_chunks.append(std::move(chunk));
+    }
+    Chunk& chunk = m_chunks.last();
+    m_sequencesByName[nameId].append(m_firstSequence + m_size);
+    chunk.nameColumn.append(nameId);
+    chunk.timeColumn.append(timestampMs);
+    chunk.dataColumn.append(data);
+    ++m_size;
+}
+
+void EventStore::clear()
+{
+    m_chunks.clear();
+    m_firstSequence += m_size;
+    m_size = 0;
+    for (QVector<qint64>& sequences : m_sequencesByName) {
+        sequences.clear();
+    }
+}
+
+void EventStore::evictOldest()
+{
+    // Only the oldest chunk is dropped, and with it the front of each name's
+    // list. Removing from the front of a Qt 6 container moves its begin
+    // pointer instead of shifting what follows, so this stays proportional
+    // to the chunk size.
+    m_chunks.removeFirst();
+    m_firstSequence += kChunkRows;
+    m_size -= kChunkRows;
+    for (QVector<qint64>& sequences : m_sequencesByName) {
+        auto end = std::lower_bound(sequences.begin(), sequences.end(), m_firstSequence);
+        sequences.erase(sequences.begin(), end);
+    }
+}
+
+int EventStore::lowerBound(qint64 timestampMs) const
+{
+    int low = 0;
+    int high = m_size;
+    while (low < high) {
+        const int mid = low + (high - low) / 2;
+        if (timestampAt(mid) < timestampMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+QVariant EventStore::valueAtPath(const QVariantList& data, const QString& path)
+{
+    QVector<EventQuery::PathStep> steps;
+    if (!EventQuery::parsePath(path, &steps)) {
+        return QVariant();
+    }
+    return valueAtPath(data, steps);
+}
+
+QVariant EventStore::valueAtPath(const QVariantList& data, const QVector<EventQuery::PathStep>& steps)
+{
+    // Walks pointers into the stored payload; queries run this per row, so
+    // copying each nested list or map on the way down would dominate.
+    const QVariantList* list = &data;
+    const QVariant* current = nullptr;
+    for (const EventQuery::PathStep& step : steps) {
+        if (step.index >= 0) {
+            if (current) {
+                if (current->typeId() != QMetaType::QVariantList) {
+                    return QVariant();
+                }
+                list = static_cast<const QVariantList*>(current->constData());
+            }
+            if (step.index >= list->size()) {
+                return QVariant();
+            }
+            current = &list->at(step.index);
+        } else if (current && current->typeId() == QMetaType::QVariantMap) {
+            const QVariantMap* map = static_cast<const QVariantMap*>(current->constData());
+            auto it = map->constFind(step.key);
+            if (it == map->constEnd()) {
+                return QVariant();
+            }
+            current = &it.value();
+        } else if (current && current->typeId() == QMetaType::QVariantHash) {
+            const QVariantHash* hash = static_cast<const QVariantHash*>(current->constData());
+            auto it = hash->constFind(step.key);
+            if (it == hash->constEnd()) {
+                return QVariant();
+            }
+            current = &it.value();
+        } else {
+            return QVariant();
+        }
+    }
+    return current ? *current : QVariant(data);
+}
+
+bool EventStore::matches(int row, const EventQuery& query) const
+{
+    const QVariantList& data = dataAt(row);
+    for (const EventQuery::Predicate& predicate : query.predicates) {
+        if (!comparePredicate(valueAtPath(data, predicate.steps), predicate)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Visitor>
+void EventStore::forEachMatch(const EventQuery& query, qint64 nowMs, Visitor visitor) const
+{
+    int firstRow = 0;
+    if (query.windowMs >= 0) {
+        firstRow = lowerBound(nowMs - query.windowMs);
+    }
+
+    if (!query.eventName.isEmpty()) {
+        const int nameId = m_nameIds.value(query.eventName, -1);
+        if (nameId < 0) {
+            return;
+        }
+        const QVector<qint64>& sequences = m_sequencesByName.at(nameId);
+        auto start = std::lower_bound(sequences.constBegin(), sequences.constEnd(), m_firstSequence + firstRow);
+        for (auto it = sequences.constEnd(); it != start;) {
+            --it;
+            const int row = static_cast<int>(*it - m_firstSequence);
+            if (matches(row, query)) {
+                visitor(row);
+            }
+        }
+        return;
+    }
+
+    for (int row = m_size - 1; row >= firstRow; --row) {
+        if (matches(row, query)) {
+            visitor(row);
+        }
+    }
+}
+
+QVector<int> EventStore::query(const EventQuery& query, qint64 nowMs, int limit, int* totalMatches) const
+{
+    QVector<int> rows;
+    int total = 0;
+    forEachMatch(query, nowMs, [&](int row) {
+        if (rows.size() < limit) {
+            rows.append(row);
+        }
+        ++total;
+    });
+    if (totalMatches) {
+        *totalMatches = total;
+    }
+    return rows;
+}
+
+QVector<EventGroupStats> EventStore::groupByName(const EventQuery& query, qint64 nowMs) const
+{
+    QHash<int, EventGroupStats> groups;
+    forEachMatch(query, nowMs, [&](int row) {
+        const int nameId = chunkAt(row).nameColumn.at(row % kChunkRows);
+        EventGroupStats& stats = groups[nameId];
+        const qint64 timestamp = timestampAt(row);
+        if (stats.count == 0) {
+            stats.name = m_names.at(nameId);
+            stats.lastMs = timestamp;
+        }
+        // Rows arrive newest first.
+        stats.firstMs = timestamp;
+        ++stats.count;
+    });
+
+    QVector<EventGroupStats> result;
+    for (EventGroupStats& stats : groups) {
+        qint64 spanMs = query.windowMs >= 0 ? query.windowMs : stats.lastMs - stats.firstMs;
+        stats.ratePerSecond = stats.count / (qMax<qint64>(spanMs, 1000) / 1000.0);
+        result.append(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const EventGroupStats& a, const EventGroupStats& b) {
+        return a.count > b.count;
+    });
+    return result;
+}
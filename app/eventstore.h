@@ -0,0 +1,121 @@
+#ifndef EVENTSTORE_H
+#define EVENTSTORE_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+
+// Parsed form of a query such as
+//   name = transfer and data[0].amount > 1000 in the last 5m group by name
+// Clauses are joined with "and". Supported clauses:
+//   name = <event>            match one event name (uses the name index)
+//   [in the] last <n><unit>   time window ending now; unit ms, s, m, h
+//   since <n><unit>           same as last
+//   <path> <op> <value>       path is data[i] followed by [i] or .key steps;
+//                             op is = == != > >= < <= or contains
+// and an optional trailing "group by name".
+struct EventQuery
+{
+    // One step of a payload path: a list index or a map key.
+    struct PathStep {
+        int index = -1;
+        QString key;
+    };
+
+    struct Predicate {
+        enum class Op { Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Contains };
+        QString path;
+        QVector<PathStep> steps;
+        Op op = Op::Equal;
+        QVariant value;
+    };
+
+    QString eventName;
+    qint64 windowMs = -1;
+    QVector<Predicate> predicates;
+    bool groupByName = false;
+
+    static EventQuery parse(const QString& text, QString* error = nullptr);
+    static bool parsePath(const QString& path, QVector<PathStep>* steps);
+};
+
+struct EventGroupStats
+{
+    QString name;
+    int count = 0;
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    double ratePerSecond = 0.0;
+};
+
+// Column-oriented store of received events. Event names are interned and
+// indexed, timestamps are kept in arrival order so time ranges are found by
+// binary search, and payloads are stored as parsed QVariants (JSON strings
+// are decoded on the way in) so queries can look inside them.
+//
+// Rows live in fixed-size chunks; once the store is full the oldest chunk is
+// dropped whole, so eviction costs one chunk no matter how large the store
+// is. Row numbers in the public API count from the oldest stored event.
+class EventStore
+{
+public:
+    static constexpr int kChunkRows = 16384;
+
+    // Rounded up to whole chunks, at least two.
+    explicit EventStore(int capacity = 1000000);
+
+    void append(const QString& name, qint64 timestampMs, const QVariantList& data);
+    // For payloads that already went through normalizePayload(), e.g. on
+    // the event pipeline's worker thread.
+    void appendNormalized(const QString& name, qint64 timestampMs, const QVariantList& data);
+    void clear();
+
+    int size() const { return m_size; }
+    QString nameAt(int row) const { return m_names.at(chunkAt(row).nameColumn.at(row % kChunkRows)); }
+    qint64 timestampAt(int row) const { return chunkAt(row).timeColumn.at(row % kChunkRows); }
+    const QVariantList& dataAt(int row) const { return chunkAt(row).dataColumn.at(row % kChunkRows); }
+
+    // Matching rows, newest first, at most limit of them. *totalMatches gets
+    // the full count.
+    QVector<int> query(const EventQuery& query, qint64 nowMs, int limit, int* totalMatches = nullptr) const;
+    QVector<EventGroupStats> groupByName(const EventQuery& query, qint64 nowMs) const;
+
+    // Decodes JSON values and JSON strings into QVariantMap/QVariantList the
+    // way the store keeps payloads. Thread-safe.
+    static QVariantList normalizePayload(const QVariantList& data);
+
+    // Resolves a path like data[0].amount against an event payload.
+    static QVariant valueAtPath(const QVariantList& data, const QString& path);
+    static QVariant valueAtPath(const QVariantList& data, const QVector<EventQuery::PathStep>& steps);
+
+private:
+    struct Chunk {
+        QVector<int> nameColumn;
+        QVector<qint64> timeColumn;
+        QVector<QVariantList> dataColumn;
+    };
+
+    const Chunk& chunkAt(int row) const { return m_chunks.at(row / kChunkRows); }
+    // First row with a timestamp at or after timestampMs.
+    int lowerBound(qint64 timestampMs) const;
+    template <typename Visitor>
+    void forEachMatch(const EventQuery& query, qint64 nowMs, Visitor visitor) const;
+    bool matches(int row, const EventQuery& query) const;
+    void evictOldest();
+
+    int m_capacity;
+    int m_size;
+    // Sequence number of row 0; grows by kChunkRows per eviction.
+    qint64 m_firstSequence;
+    qint64 m_lastTimestampMs;
+    QStringList m_names;
+    QHash<QString, int> m_nameIds;
+    QVector<Chunk> m_chunks;
+    // Per name, the sequence numbers (not row numbers) of its events, so
+    // evicting a chunk only trims the front of each list.
+    QVector<QVector<qint64>> m_sequencesByName;
+};
+
+#endif // EVENTSTORE_H
@@ -0,0 +1,142 @@
+#include "invocationcomparer.h"
+
+#include <QObject>
+#include <QMetaMethod>
+#include <QMetaType>
+#include <QElapsedTimer>
+#include <QByteArrayList>
+#include <QStringList>
+
+InvocationComparison InvocationComparer::compare(QObject* target, const QMetaMethod& method, const QVariantList& args,
+                                                 int iterations, const RemoteInvoker& remoteInvoker)
+{
+    InvocationComparison comparison;
+    comparison.methodName = QString::fromUtf8(method.name());
+    comparison.iterations = qMax(1, iterations);
+
+    // One untimed call on each side so lazy initialisation in the module or
+    // the transport is not charged to the first sample.
+    QVariant localResult;
+    QString error;
+    if (!invokeLocal(target, method, args, &localResult, &error)) {
+        comparison.error = error;
+        return comparison;
+    }
+    bool remoteOk = false;
+    QVariant remoteResult = remoteInvoker(comparison.methodName, args, &remoteOk);
+    if (!remoteOk) {
+        comparison.error = "Remote client not available";
+        return comparison;
+    }
+    comparison.resultsMatch = localResult == remoteResult;
+
+    QVector<double> localSamples;
+    QVector<double> remoteSamples;
+    localSamples.reserve(comparison.iterations);
+    remoteSamples.reserve(comparison.iterations);
+
+    // Interleave the two paths so drift (thermal, other load) hits both.
+    QElapsedTimer timer;
+    for (int i = 0; i < comparison.iterations; ++i) {
+        QVariant result;
+        timer.start();
+        bool ok = invokeLocal(target, method, args, &result);
+        double elapsedMs = timer.nsecsElapsed() / 1e6;
+        if (ok) {
+            localSamples.append(elapsedMs);
+        } else {
+            ++comparison.localFailures;
+        }
+
+        timer.start();
+        remoteInvoker(comparison.methodName, args, &remoteOk);
+        elapsedMs = timer.nsecsElapsed() / 1e6;
+        if (remoteOk) {
+            remoteSamples.append(elapsedMs);
+        } else {
+            ++comparison.remoteFailures;
+        }
+    }
+
+    comparison.local = LatencySummary::fromSamples(localSamples);
+    comparison.remote = LatencySummary::fromSamples(remoteSamples);
+    return comparison;
+}
+
+bool InvocationComparer::invokeLocal(QObject* target, const QMetaMethod& method, const QVariantList& args,
+                                     QVariant* result, QString* error)
+{
+    const int parameterCount = method.parameterCount();
+    if (!target || parameterCount > 10) {
+        if (error) {
+            *error = target ? "Methods with more than 10 parameters are not supported" : "No local instance";
+        }
+        return false;
+    }
+
+    // Fill both lists completely before taking pointers into them.
+    QVariantList converted;
+    QByteArrayList typeNames;
+    for (int p = 0; p < parameterCount; ++p) {
+        QVariant value = p < args.size() ? args.at(p) : QVariant();
+        if (!value.convert(method.parameterMetaType(p))) {
+            if (error) {
+                *error = QString("Cannot convert argument %1 to %2").arg(p).arg(QString::fromUtf8(method.parameterTypeName(p)));
+            }
+            return false;
+        }
+        converted.append(value);
+        typeNames.append(method.parameterTypeName(p));
+    }
+
+    QGenericArgument genericArgs[10];
+    for (int p = 0; p < parameterCount; ++p) {
+        genericArgs[p] = QGenericArgument(typeNames.at(p).constData(), converted.at(p).constData());
+    }
+
+    QVariant returnValue;
+    QGenericReturnArgument returnArg;
+    const QMetaType returnType = method.returnMetaType();
+    if (returnType == QMetaType::fromType<QVariant>()) {
+        returnArg = QGenericReturnArgument(method.typeName(), &returnValue);
+    } else if (returnType.id() != QMetaType::Void) {
+        returnValue = QVariant(returnType);
+        returnArg = QGenericReturnArgument(method.typeName(), returnValue.data());
+    }
+
+    bool ok = method.invoke(target, Qt::DirectConnection, returnArg,
+                            genericArgs[0], genericArgs[1], genericArgs[2], genericArgs[3], genericArgs[4],
+                            genericArgs[5], genericArgs[6], genericArgs[7], genericArgs[8], genericArgs[9]);
+    if (!ok) {
+        if (error) {
+            *error = "QMetaMethod::invoke failed";
+        }
+        return false;
+    }
+
+    if (result) {
+        *result = returnValue;
+    }
+    return true;
+}
+
+bool InvocationComparer::mayHaveSideEffects(const QMetaMethod& method)
+{
+    if (method.returnMetaType().id() == QMetaType::Void) {
+        return true;
+    }
+
+    static const QStringList mutatingPrefixes = {
+        "set", "add", "remove", "delete", "create", "insert", "update", "write", "save", "store",
+        "send", "publish", "emit", "post", "push", "pop", "start", "stop", "init", "load", "unload",
+        "install", "uninstall", "register", "unregister", "reset", "clear", "close", "open", "connect",
+        "disconnect", "subscribe", "unsubscribe", "approve", "sign", "transfer", "execute", "run"
+    };
+    const QString name = QString::fromUtf8(method.name());
+    for (const QString& prefix : mutatingPrefixes) {
+        if (name.startsWith(prefix) && (name.size() == prefix.size() || !name.at(prefix.size()).isLower())) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,51 @@
+#ifndef INVOCATIONCOMPARER_H
+#define INVOCATIONCOMPARER_H
+
+#include <QString>
+#include <QVariant>
+#include <functional>
+
+#include "latencystats.h"
+
+class QObject;
+class QMetaMethod;
+
+struct InvocationComparison
+{
+    QString methodName;
+    int iterations = 0;
+    LatencySummary local;
+    LatencySummary remote;
+    int localFailures = 0;
+    int remoteFailures = 0;
+    bool resultsMatch = true;
+    QString error;
+
+    // Time the IPC path adds to each call, by median and by mean.
+    double overheadP50Ms() const { return remote.p50Ms - local.p50Ms; }
+    double overheadMeanMs() const { return remote.meanMs - local.meanMs; }
+};
+
+// Runs the same call against the in-process plugin instance (direct
+// QMetaMethod::invoke) and through the remote host, to separate time spent
+// in the module from time spent in the transport.
+class InvocationComparer
+{
+public:
+    using RemoteInvoker = std::function<QVariant(const QString& methodName, const QVariantList& args, bool* ok)>;
+
+    static InvocationComparison compare(QObject* target, const QMetaMethod& method, const QVariantList& args,
+                                        int iterations, const RemoteInvoker& remoteInvoker);
+
+    // Calls method on target directly. args are converted to the declared
+    // parameter types; at most 10 parameters are supported.
+    static bool invokeLocal(QObject* target, const QMetaMethod& method, const QVariantList& args,
+                            QVariant* result, QString* error = nullptr);
+
+    // Best-effort guess from the method name and signature. Qt metadata has
+    // no notion of const or pure methods, so anything that returns nothing
+    // or is named like a mutation is treated as having side effects.
+    static bool mayHaveSideEffects(const QMetaMethod& method);
+};
+
+#endif // INVOCATIONCOMPARER_H
@@ -0,0 +1,134 @@
+#include "latencystats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+LatencySummary LatencySummary::fromSamples(QVector<double> samplesMs)
+{
+    LatencySummary summary;
+    summary.count = samplesMs.size();
+    if (samplesMs.isEmpty()) {
+        return summary;
+    }
+
+    std::sort(samplesMs.begin(), samplesMs.end());
+    summary.minMs = samplesMs.first();
+    summary.maxMs = samplesMs.last();
+
+    double sum = 0.0;
+    for (double v : std::as_const(samplesMs)) {
+        sum += v;
+    }
+    summary.meanMs = sum / samplesMs.size();
+
+    double squares = 0.0;
+    for (double v : std::as_const(samplesMs)) {
+        squares += (v - summary.meanMs) * (v - summary.meanMs);
+    }
+    summary.stddevMs = samplesMs.size() > 1 ? std::sqrt(squares / (samplesMs.size() - 1)) : 0.0;
+
+    summary.p50Ms = percentile(samplesMs, 0.50);
+    summary.p90Ms = percentile(samplesMs, 0.90);
+    summary.p99Ms = percentile(samplesMs, 0.99);
+    return summary;
+}
+
+double LatencySummary::percentile(const QVector<double>& sortedMs, double fraction)
+{
+    if (sortedMs.isEmpty()) {
+        return 0.0;
+    }
+    double rank = qBound(0.0, fraction, 1.0) * (sortedMs.size() - 1);
+    int lower = static_cast<int>(std::floor(rank));
+    int upper = qMin(lower + 1, static_cast<int>(sortedMs.size()) - 1);
+    double weight = rank - lower;
+    return sortedMs.at(lower) * (1.0 - weight) + sortedMs.at(upper) * weight;
+}
+
+QString LatencySummary::toString() const
+{
+    return QString("n=%1 min %2 p50 %3 p90 %4 p99 %5 max %6 mean %7 sd %8 ms")
+        .arg(count)
+        .arg(minMs, 0, 'f', 3)
+        .arg(p50Ms, 0, 'f', 3)
+        .arg(p90Ms, 0, 'f', 3)
+        .arg(p99Ms, 0, 'f', 3)
+        .arg(maxMs, 0, 'f', 3)
+        .arg(meanMs, 0, 'f', 3)
+        .arg(stddevMs, 0, 'f', 3);
+}
+
+const QVector<double>& LatencyHistogram::boundsMs()
+{
+    static const QVector<double> bounds = {
+        0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000
+    };
+    return bounds;
+}
+
+void LatencyHistogram::add(double ms)
+{
+    const QVector<double>& bounds = boundsMs();
+    if (counts.isEmpty()) {
+        counts.resize(bounds.size() + 1);
+    }
+    ms = qMax(0.0, ms);
+    const int bucket = static_cast<int>(std::lower_bound(bounds.constBegin(), bounds.constEnd(), ms) - bounds.constBegin());
+    ++counts[bucket];
+    ++count;
+    sumMs += ms;
+    maxMs = qMax(maxMs, ms);
+}
+
+void LatencyHistogram::clear()
+{
+    counts.clear();
+    count = 0;
+    sumMs = 0.0;
+    maxMs = 0.0;
+}
+
+double LatencyHistogram::percentile(double fraction) const
+{
+    if (count == 0) {
+        return 0.0;
+    }
+    const QVector<double>& bounds = boundsMs();
+    const double rank = qBound(0.0, fraction, 1.0) * count;
+    quint64 seen = 0;
+    for (int i = 0; i < counts.size(); ++i) {
+        if (counts.at(i) == 0) {
+            continue;
+        }
+        if (seen + counts.at(i) >= rank) {
+            const double lower = i > 0 ? bounds.at(i - 1) : 0.0;
+            const double upper = i < bounds.size() ? qMin(bounds.at(i), maxMs) : maxMs;
+            const double weight = (rank - seen) / counts.at(i);
+            return lower + (qMax(lower, upper) - lower) * weight;
+        }
+        seen += counts.at(i);
+    }
+    return maxMs;
+}
+
+QString LatencyHistogram::toText() const
+{
+    if (count == 0) {
+        return QString();
+    }
+    const QVector<double>& bounds = boundsMs();
+    const quint64 largest = *std::max_element(counts.constBegin(), counts.constEnd());
+    QString text;
+    for (int i = 0; i < counts.size(); ++i) {
+        if (counts.at(i) == 0) {
+            continue;
+        }
+        const QString label = i < bounds.size()
+            ? QString("<= %1 ms").arg(bounds.at(i))
+            : QString(" > %1 ms").arg(bounds.last());
+        const int bar = qMax(1, static_cast<int>(counts.at(i) * 30 / largest));
+        text += QString("%1 %2 %3\n").arg(label, 12).arg(QString(bar, QChar('#')), -30).arg(counts.at(i));
+    }
+    return text;
+}
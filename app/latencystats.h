@@ -0,0 +1,51 @@
+#ifndef LATENCYSTATS_H
+#define LATENCYSTATS_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Distribution summary for a set of latency samples in milliseconds.
+struct LatencySummary
+{
+    int count = 0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double meanMs = 0.0;
+    double stddevMs = 0.0;
+    double p50Ms = 0.0;
+    double p90Ms = 0.0;
+    double p99Ms = 0.0;
+
+    static LatencySummary fromSamples(QVector<double> samplesMs);
+
+    // Linear interpolation between closest ranks; sortedMs must be ascending.
+    static double percentile(const QVector<double>& sortedMs, double fraction);
+
+    QString toString() const;
+};
+
+// Latency distribution with fixed, roughly logarithmic buckets. Adding a
+// sample is O(1) and memory does not grow, so it suits streams that never
+// end; percentiles are interpolated within the bucket they fall in.
+struct LatencyHistogram
+{
+    // Upper bounds of the buckets in milliseconds; one more bucket past the
+    // last bound catches everything slower.
+    static const QVector<double>& boundsMs();
+
+    QVector<quint64> counts;
+    quint64 count = 0;
+    double sumMs = 0.0;
+    double maxMs = 0.0;
+
+    void add(double ms);
+    void clear();
+    double meanMs() const { return count > 0 ? sumMs / count : 0.0; }
+    double percentile(double fraction) const;
+
+    // One line per non-empty bucket with a bar scaled to the largest one.
+    QString toText() const;
+};
+
+#endif // LATENCYSTATS_H
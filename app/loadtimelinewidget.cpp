@@ -0,0 +1,102 @@
+#include "loadtimelinewidget.h"
+#include "modulegraphloader.h"
+
+#include <QPainter>
+
+namespace {
+const int kRowHeight = 22;
+const int kLabelWidth = 180;
+}
+
+LoadTimelineWidget::LoadTimelineWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(kRowHeight * 2);
+}
+
+void LoadTimelineWidget::setLoader(ModuleGraphLoader* loader)
+{
+    if (m_loader) {
+        disconnect(m_loader, nullptr, this, nullptr);
+    }
+    m_loader = loader;
+    if (m_loader) {
+        auto refresh = [this]() {
+            setMinimumHeight(kRowHeight * (m_loader->records().size() + 2));
+            update();
+        };
+        connect(m_loader, &ModuleGraphLoader::moduleStarted, this, refresh);
+        connect(m_loader, &ModuleGraphLoader::moduleFinished, this, refresh);
+        connect(m_loader, &ModuleGraphLoader::finished, this, refresh);
+    }
+    update();
+}
+
+QSize LoadTimelineWidget::sizeHint() const
+{
+    int rows = m_loader ? m_loader->records().size() : 0;
+    return QSize(600, kRowHeight * (rows + 2));
+}
+
+void LoadTimelineWidget::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#252525"));
+
+    if (!m_loader || m_loader->records().isEmpty()) {
+        painter.setPen(QColor("#888"));
+        painter.drawText(rect(), Qt::AlignCenter, "No modules loaded yet");
+        return;
+    }
+
+    const QVector<ModuleLoadRecord>& records = m_loader->records();
+    qint64 spanMs = m_loader->totalMs();
+    for (const ModuleLoadRecord& record : records) {
+        spanMs = qMax(spanMs, record.endMs);
+        spanMs = qMax(spanMs, record.startMs);
+    }
+    spanMs = qMax<qint64>(spanMs, 1);
+
+    const QRect barArea(kLabelWidth, 0, qMax(1, width() - kLabelWidth - 80), height());
+    auto xAt = [&](qint64 ms) { return barArea.left() + static_cast<int>(ms * barArea.width() / spanMs); };
+
+    for (int i = 0; i < records.size(); ++i) {
+        const ModuleLoadRecord& record = records.at(i);
+        const QRect row(0, i * kRowHeight + 4, width(), kRowHeight);
+
+        painter.setPen(record.path.isEmpty() ? QColor("#ff6b6b") : QColor("#e0e0e0"));
+        QString label = record.name;
+        if (!record.dependencies.isEmpty()) {
+            label += QString(" <- %1").arg(record.dependencies.join(", "));
+        }
+        painter.drawText(row.adjusted(6, 0, -(width() - kLabelWidth) - 6, 0), Qt::AlignVCenter | Qt::AlignLeft,
+                         painter.fontMetrics().elidedText(label, Qt::ElideRight, kLabelWidth - 12));
+
+        if (record.startMs < 0) {
+            continue;
+        }
+        const bool running = record.endMs < 0;
+        const qint64 endMs = running ? spanMs : record.endMs;
+        QRect bar(xAt(record.startMs), row.top() + 4, qMax(2, xAt(endMs) - xAt(record.startMs)), kRowHeight - 8);
+        QColor color = running ? QColor("#6bb") : (record.ok ? QColor("#5a9") : QColor("#ff6b6b"));
+        if (record.alreadyLoaded) {
+            color = QColor("#555");
+        }
+        painter.fillRect(bar, color);
+
+        QString duration = running ? "..." : QString("%1 ms").arg(endMs - record.startMs);
+        if (record.alreadyLoaded) {
+            duration = "already loaded";
+        } else if (!record.ok && !running) {
+            duration = record.error;
+        }
+        painter.setPen(QColor("#b0b0b0"));
+        painter.drawText(QRect(bar.right() + 6, row.top(), width() - bar.right() - 6, kRowHeight),
+                         Qt::AlignVCenter | Qt::AlignLeft, duration);
+    }
+
+    painter.setPen(QColor("#888"));
+    painter.drawText(QRect(kLabelWidth, records.size() * kRowHeight + 4, barArea.width(), kRowHeight),
+                     Qt::AlignVCenter | Qt::AlignLeft,
+                     QString("total %1 ms").arg(m_loader->totalMs()));
+}
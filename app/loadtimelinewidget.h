@@ -0,0 +1,29 @@
+#ifndef LOADTIMELINEWIDGET_H
+#define LOADTIMELINEWIDGET_H
+
+#include <QWidget>
+#include <QPointer>
+
+class ModuleGraphLoader;
+
+// One bar per module showing when its load started and finished, in
+// dependency order, for the graph most recently loaded by a ModuleGraphLoader.
+class LoadTimelineWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LoadTimelineWidget(QWidget* parent = nullptr);
+
+    void setLoader(ModuleGraphLoader* loader);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QPointer<ModuleGraphLoader> m_loader;
+};
+
+#endif // LOADTIMELINEWIDGET_H
@@ -1,13 +1,64 @@
 #include "mainwindow.h"
+#include "benchmarkrunner.h"
+#include "metricsexporter.h"
+#include "moduleprobe.h"
+#include "regressionreport.h"
+#include "soaktest.h"
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QScopedPointer>
+#include <QTimer>
+#include <csignal>
+#include <iostream>
+
+namespace {
+
+// Modes that never open a window run on a plain QCoreApplication so they
+// work without a display.
+bool isHeadless(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        const QByteArray arg(argv[i]);
+        if (arg == "--compare" || arg == "--bench" || arg == "--soak" || arg == "--probe"
+            || arg.startsWith("--compare=") || arg.startsWith("--bench=")) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Set from the signal handler; a timer turns it into a normal quit so the
+// probe unloads its module and stops its hosts on the way out.
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+void writeReport(const QString& path, const QJsonObject& report)
+{
+    QSaveFile file(path);
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(report).toJson(QJsonDocument::Indented));
+        file.commit();
+    } else {
+        std::cerr << "Cannot write report: " << file.errorString().toStdString() << std::endl;
+    }
+}
+
+}
 
 int main(int argc, char *argv[])
 {
-    QApplication app(argc, argv);
-    app.setApplicationName("logos-module-viewer");
-    app.setApplicationVersion("1.0.0");
+    QScopedPointer<QCoreApplication> app(isHeadless(argc, argv)
+        ? new QCoreApplication(argc, argv)
+        : new QApplication(argc, argv));
+    app->setApplicationName("logos-module-viewer");
+    app->setApplicationVersion("1.0.0");
 
     QCommandLineParser parser;
     parser.setApplicationDescription("Logos Module Viewer - Inspect Qt plugin modules");
@@ -19,16 +70,237 @@ int main(int argc, char *argv[])
                                    "path");
     parser.addOption(moduleOption);
 
-    parser.process(app);
+    QCommandLineOption compareOption("compare",
+                                     "Benchmark --module (baseline) against this build of the same module and exit",
+                                     "path");
+    parser.addOption(compareOption);
+
+    QCommandLineOption callsOption("calls",
+                                   "JSON call file for --compare and --soak: [{\"method\": ..., \"args\": [...], \"iterations\": N}]",
+                                   "file");
+    parser.addOption(callsOption);
+
+    QCommandLineOption thresholdOption("regression-threshold",
+                                       "Median latency increase, in percent, that fails --compare (default 10)",
+                                       "percent", "10");
+    parser.addOption(thresholdOption);
+
+    QCommandLineOption roundsOption("rounds",
+                                    "Benchmark runs per build for --compare, alternating builds (default 1)",
+                                    "count", "1");
+    parser.addOption(roundsOption);
+
+    QCommandLineOption reportOption("report",
+                                    "Also write the --compare or --soak report as JSON to this file",
+                                    "file");
+    parser.addOption(reportOption);
+
+    QCommandLineOption soakOption("soak",
+                                  "Load, call and unload --module over and over, then report resource growth and exit");
+    parser.addOption(soakOption);
+
+    QCommandLineOption cyclesOption("cycles",
+                                    "Number of --soak cycles (default 100 unless --duration is given)",
+                                    "count");
+    parser.addOption(cyclesOption);
+
+    QCommandLineOption durationOption("duration",
+                                      "Run --soak for this many seconds",
+                                      "seconds");
+    parser.addOption(durationOption);
+
+    QCommandLineOption soakEventsOption("soak-events",
+                                        "Comma-separated events to subscribe to in every --soak cycle",
+                                        "names");
+    parser.addOption(soakEventsOption);
+
+    QCommandLineOption metricsFileOption("metrics-file",
+                                         "Rewrite call, event and connection metrics to this file in OpenMetrics format",
+                                         "file");
+    parser.addOption(metricsFileOption);
+
+    QCommandLineOption metricsIntervalOption("metrics-interval",
+                                             "How often --metrics-file is rewritten, in milliseconds (default 5000)",
+                                             "ms", "5000");
+    parser.addOption(metricsIntervalOption);
+
+    QCommandLineOption metricsPortOption("metrics-port",
+                                         "Serve the same metrics at http://127.0.0.1:<port>/metrics",
+                                         "port");
+    parser.addOption(metricsPortOption);
+
+    QCommandLineOption probeOption("probe",
+                                   "Run headless against --module, repeating the calls from --calls, and export metrics until stopped");
+    parser.addOption(probeOption);
+
+    QCommandLineOption probeIntervalOption("probe-interval",
+                                           "Milliseconds between --probe call rounds (default 1000)",
+                                           "ms", "1000");
+    parser.addOption(probeIntervalOption);
+
+    QCommandLineOption probeEventsOption("probe-events",
+                                         "Comma-separated events --probe subscribes to and counts",
+                                         "names");
+    parser.addOption(probeEventsOption);
+
+    QCommandLineOption benchOption("bench", "Benchmark one module build (used by --compare)", "path");
+    benchOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(benchOption);
+
+    QCommandLineOption benchOutputOption("bench-output", "Where --bench writes its results", "file");
+    benchOutputOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(benchOutputOption);
+
+    parser.process(*app);
 
     QString modulePath;
     if (parser.isSet(moduleOption)) {
         modulePath = parser.value(moduleOption);
     }
 
+    if (parser.isSet(benchOption)) {
+        return BenchmarkRunner::runChild(parser.value(benchOption), parser.value(callsOption),
+                                         parser.value(benchOutputOption));
+    }
+
+    if (parser.isSet(compareOption)) {
+        if (modulePath.isEmpty()) {
+            std::cerr << "--compare needs the baseline build in --module" << std::endl;
+            return 2;
+        }
+
+        RegressionRunner::Options options;
+        options.baselinePath = modulePath;
+        options.candidatePath = parser.value(compareOption);
+        options.callsPath = parser.value(callsOption);
+        options.thresholdPercent = parser.value(thresholdOption).toDouble();
+        options.rounds = qMax(1, parser.value(roundsOption).toInt());
+
+        int exitCode = 2;
+        RegressionRunner runner;
+        QObject::connect(&runner, &RegressionRunner::progress, [](const QString& message) {
+            std::cout << message.toStdString() << std::endl;
+        });
+        QObject::connect(&runner, &RegressionRunner::finished, [&](const RegressionReport& report) {
+            std::cout << std::endl << report.toText().toStdString() << std::flush;
+            if (parser.isSet(reportOption)) {
+                writeReport(parser.value(reportOption), report.toJson());
+            }
+            exitCode = report.exitCode();
+            QCoreApplication::quit();
+        });
+        QTimer::singleShot(0, &runner, [&runner, options]() { runner.start(options); });
+        app->exec();
+        return exitCode;
+    }
+
+    if (parser.isSet(soakOption)) {
+        if (modulePath.isEmpty()) {
+            std::cerr << "--soak needs the module in --module" << std::endl;
+            return 2;
+        }
+
+        SoakTest::Options options;
+        options.modulePath = modulePath;
+        options.cycles = parser.value(cyclesOption).toInt();
+        options.durationSeconds = parser.value(durationOption).toInt();
+        if (options.cycles <= 0 && options.durationSeconds <= 0) {
+            options.cycles = 100;
+        }
+        options.callsPath = parser.value(callsOption);
+        options.events = parser.value(soakEventsOption).split(',', Qt::SkipEmptyParts);
+        for (QString& event : options.events) {
+            event = event.trimmed();
+        }
+
+        const SoakReport report = SoakTest::run(options);
+        std::cout << std::endl << report.toText().toStdString() << std::flush;
+        if (parser.isSet(reportOption)) {
+            writeReport(parser.value(reportOption), report.toJson());
+        }
+        return report.exitCode();
+    }
+
+    // Both the probe and the window feed a registry; an exporter publishes
+    // it if asked to.
+    auto startExporter = [&](MetricsRegistry* registry) -> MetricsExporter* {
+        if (!parser.isSet(metricsFileOption) && !parser.isSet(metricsPortOption)) {
+            return nullptr;
+        }
+        QScopedPointer<MetricsExporter> exporter(new MetricsExporter(registry));
+        QString error;
+        if (parser.isSet(metricsFileOption)
+            && !exporter->startFile(parser.value(metricsFileOption), parser.value(metricsIntervalOption).toInt(), &error)) {
+            std::cerr << error.toStdString() << std::endl;
+            return nullptr;
+        }
+        if (parser.isSet(metricsPortOption)) {
+            bool portOk = false;
+            const uint port = parser.value(metricsPortOption).toUInt(&portOk);
+            if (!portOk || port == 0 || port > 65535) {
+                std::cerr << "--metrics-port needs a port number between 1 and 65535" << std::endl;
+                return nullptr;
+            }
+            if (!exporter->startHttp(static_cast<quint16>(port), &error)) {
+                std::cerr << error.toStdString() << std::endl;
+                return nullptr;
+            }
+        }
+        return exporter.take();
+    };
+    const bool exportRequested = parser.isSet(metricsFileOption) || parser.isSet(metricsPortOption);
+
+    if (parser.isSet(probeOption)) {
+        if (modulePath.isEmpty()) {
+            std::cerr << "--probe needs the module in --module" << std::endl;
+            return 2;
+        }
+        if (!exportRequested) {
+            std::cerr << "--probe needs --metrics-file or --metrics-port" << std::endl;
+            return 2;
+        }
+
+        MetricsRegistry registry;
+        ModuleProbe probe(&registry);
+        QScopedPointer<MetricsExporter> exporter(startExporter(&registry));
+        if (!exporter) {
+            return 2;
+        }
+
+        ModuleProbe::Options options;
+        options.modulePath = modulePath;
+        options.callsPath = parser.value(callsOption);
+        options.intervalMs = parser.value(probeIntervalOption).toInt();
+        options.events = parser.value(probeEventsOption).split(',', Qt::SkipEmptyParts);
+        for (QString& event : options.events) {
+            event = event.trimmed();
+        }
+        QString error;
+        if (!probe.start(options, &error)) {
+            std::cerr << "Probe failed: " << error.toStdString() << std::endl;
+            return 2;
+        }
+
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+        QTimer stopTimer;
+        stopTimer.setInterval(200);
+        QObject::connect(&stopTimer, &QTimer::timeout, app.data(), [&app]() {
+            if (stopRequested) {
+                std::cout << "Stopping probe" << std::endl;
+                app->quit();
+            }
+        });
+        stopTimer.start();
+        return app->exec();
+    }
+
     MainWindow window(modulePath);
+    QScopedPointer<MetricsExporter> exporter(startExporter(window.metrics()));
+    if (exportRequested && !exporter) {
+        return 2;
+    }
     window.show();
 
-    return app.exec();
+    return app->exec();
 }
-
@@ -6,7 +6,6 @@
 #include <QLabel>
 #include <QTreeWidget>
 #include <QHeaderView>
-#include <QPluginLoader>
 #include <QMetaObject>
 #include <QMetaMethod>
 #include <QFileInfo>
@@ -21,37 +20,69 @@
 #include <QCheckBox>
 #include <QPushButton>
 #include <QFrame>
-#include <QTextEdit>
-#include <QTextCursor>
+#include <QPlainTextEdit>
+#include <QComboBox>
+#include <QScrollBar>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QDateTime>
 #include <QSplitter>
+#include <QDockWidget>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QDialog>
+#include <QPointer>
+#include <QTimer>
 #include <iostream>
 
+#include "benchmarkrunner.h"
+#include "eventquerypanel.h"
+#include "invocationcomparer.h"
+#include "loadtimelinewidget.h"
+#include "modulegraphloader.h"
+#include "modulesession.h"
+#include "monotonicclock.h"
+#include "payloadsweepchart.h"
+#include "regressionreport.h"
+#include "resourcemonitor.h"
+#include "resourcemonitorwidget.h"
+#include "sparklinewidget.h"
 #include "logos_api.h"
 #include "logos_api_client.h"
 
-extern "C" {
-    void logos_core_set_plugins_dir(const char* plugins_dir);
-    void logos_core_start();
-    void logos_core_cleanup();
-    char* logos_core_process_plugin(const char* plugin_path);
-    int logos_core_load_plugin(const char* plugin_name);
-}
-
 MainWindow::MainWindow(const QString& modulePath, QWidget *parent)
     : QMainWindow(parent)
     , m_modulePath(modulePath)
     , m_headerLabel(nullptr)
     , m_methodsTree(nullptr)
-    , m_pluginLoader(nullptr)
+    , m_session(new ModuleSession(this))
     , m_pluginInstance(nullptr)
-    , m_coreInitialized(false)
-    , m_logosAPI(nullptr)
+    , m_connectionPool(nullptr)
+    , m_connectionLabel(nullptr)
     , m_eventNameInput(nullptr)
     , m_eventLog(nullptr)
+    , m_overflowPolicyCombo(nullptr)
+    , m_eventCountersLabel(nullptr)
+    , m_eventCountersTimer(nullptr)
+    , m_eventPipeline(new EventPipeline(this))
+    , m_emitPathInput(nullptr)
+    , m_eventStatsTree(nullptr)
+    , m_eventLagLabel(nullptr)
+    , m_eventQueryPanel(nullptr)
+    , m_loadTimeline(nullptr)
+    , m_regressionRunner(nullptr)
+    , m_resourceMonitor(new ResourceMonitor(this))
+    , m_resourceMonitorWidget(nullptr)
+    , m_hostPidLabel(nullptr)
 {
+    connect(m_eventPipeline, &EventPipeline::batchReady, this, &MainWindow::onEventBatch);
+    connect(m_session, &ModuleSession::dependenciesResolved, this, [this](int dependencyCount) {
+        m_headerLabel->setText(QString("<span style='color: #888;'>Loading %1 and %2 dependencies...</span>")
+            .arg(m_session->moduleName().toHtmlEscaped())
+            .arg(dependencyCount));
+        // Loading blocks without returning to the event loop; paint now.
+        m_headerLabel->repaint();
+    });
     setupUi();
 
     if (!m_modulePath.isEmpty()) {
@@ -61,16 +92,15 @@ MainWindow::MainWindow(const QString& modulePath, QWidget *parent)
 
 MainWindow::~MainWindow()
 {
-    if (m_pluginLoader) {
-        m_pluginLoader->unload();
-        delete m_pluginLoader;
-    }
-    if (m_logosAPI) {
-        delete m_logosAPI;
-    }
-    if (m_coreInitialized) {
-        logos_core_cleanup();
-    }
+    stopAllWatchers();
+    // The session owns the connection pool; the replicas it tears down must
+    // go before the pipeline their event callbacks feed.
+    m_connectionPool = nullptr;
+    m_pluginInstance = nullptr;
+    delete m_session;
+    m_session = nullptr;
+    delete m_eventPipeline;
+    m_eventPipeline = nullptr;
 }
 
 void MainWindow::setupUi()
@@ -105,6 +135,33 @@ void MainWindow::setupUi()
     );
     layout->addWidget(m_headerLabel);
 
+    m_connectionLabel = new QLabel("Connection: -", this);
+    m_connectionLabel->setStyleSheet(
+        "QLabel {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  color: #888;"
+        "}"
+    );
+    QHBoxLayout* connectionLayout = new QHBoxLayout();
+    connectionLayout->addWidget(m_connectionLabel, 1);
+
+    QPushButton* compareBuildButton = new QPushButton("Compare Build...", this);
+    compareBuildButton->setToolTip("Benchmark this module against another build of it, using the calls in the forms below");
+    compareBuildButton->setStyleSheet(
+        "QPushButton {"
+        "  background-color: #3d3d3d;"
+        "  color: #e0e0e0;"
+        "  border: 1px solid #4d4d4d;"
+        "  padding: 4px 12px;"
+        "  border-radius: 4px;"
+        "}"
+        "QPushButton:hover { background-color: #4d4d4d; }"
+    );
+    connect(compareBuildButton, &QPushButton::clicked, this, &MainWindow::onCompareBuild);
+    connectionLayout->addWidget(compareBuildButton);
+    layout->addLayout(connectionLayout);
+
     QLabel* eventLabel = new QLabel("Event Subscription", this);
     eventLabel->setStyleSheet(
         "QLabel {"
@@ -153,13 +210,50 @@ void MainWindow::setupUi()
     connect(subscribeButton, &QPushButton::clicked, this, &MainWindow::onSubscribeEvent);
     eventInputLayout->addWidget(subscribeButton);
 
+    m_overflowPolicyCombo = new QComboBox(this);
+    m_overflowPolicyCombo->setToolTip("What to do when events arrive faster than the viewer can show them");
+    m_overflowPolicyCombo->addItem("Drop oldest", QVariant::fromValue(EventPipeline::OverflowPolicy::DropOldest));
+    m_overflowPolicyCombo->addItem("Drop newest", QVariant::fromValue(EventPipeline::OverflowPolicy::DropNewest));
+    m_overflowPolicyCombo->addItem("Sample 1 in 10", QVariant::fromValue(EventPipeline::OverflowPolicy::Sample));
+    m_overflowPolicyCombo->setStyleSheet(
+        "QComboBox {"
+        "  padding: 7px 10px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "}"
+    );
+    connect(m_overflowPolicyCombo, &QComboBox::currentIndexChanged, this, &MainWindow::onOverflowPolicyChanged);
+    eventInputLayout->addWidget(m_overflowPolicyCombo);
+
     layout->addLayout(eventInputLayout);
 
-    m_eventLog = new QTextEdit(this);
+    m_eventCountersLabel = new QLabel(this);
+    m_eventCountersLabel->setStyleSheet(
+        "QLabel {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  color: #888;"
+        "}"
+    );
+    layout->addWidget(m_eventCountersLabel);
+
+    m_eventCountersTimer = new QTimer(this);
+    m_eventCountersTimer->setInterval(250);
+    connect(m_eventCountersTimer, &QTimer::timeout, this, &MainWindow::updateEventCounters);
+    connect(m_eventCountersTimer, &QTimer::timeout, this, &MainWindow::updateEventStats);
+    m_eventCountersTimer->start();
+    updateEventCounters();
+
+    // Plain text with a block limit keeps appends cheap and memory bounded
+    // when events arrive by the thousand; older lines scroll out.
+    m_eventLog = new QPlainTextEdit(this);
     m_eventLog->setReadOnly(true);
+    m_eventLog->setMaximumBlockCount(50000);
     m_eventLog->setMinimumHeight(150);
     m_eventLog->setStyleSheet(
-        "QTextEdit {"
+        "QPlainTextEdit {"
         "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
         "  font-size: 12px;"
         "  border: 1px solid #4d4d4d;"
@@ -171,6 +265,80 @@ void MainWindow::setupUi()
     );
     m_eventLog->setPlaceholderText("Event log will appear here...");
 
+    // Per-event rates and latency, one row per subscription.
+    QWidget* eventStatsPanel = new QWidget(this);
+    QVBoxLayout* eventStatsLayout = new QVBoxLayout(eventStatsPanel);
+    eventStatsLayout->setContentsMargins(0, 0, 0, 0);
+    eventStatsLayout->setSpacing(6);
+
+    QHBoxLayout* emitPathLayout = new QHBoxLayout();
+    QLabel* emitPathLabel = new QLabel("Emit timestamp", eventStatsPanel);
+    emitPathLabel->setStyleSheet("color: #b0b0b0; font-size: 12px;");
+    emitPathLayout->addWidget(emitPathLabel);
+    m_emitPathInput = new QLineEdit(m_eventMetrics.emitTimestampPath(), eventStatsPanel);
+    m_emitPathInput->setPlaceholderText("path, e.g. data[0].timestamp (empty: off)");
+    m_emitPathInput->setToolTip("Where events carry the time they were emitted, used for emit-to-receive latency.\n"
+                                "Epoch seconds, ms, us or ns, or an ISO 8601 string.");
+    m_emitPathInput->setStyleSheet(
+        "QLineEdit {"
+        "  padding: 4px 8px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 12px;"
+        "}"
+        "QLineEdit:focus {"
+        "  border: 1px solid #5a9;"
+        "}"
+    );
+    connect(m_emitPathInput, &QLineEdit::editingFinished, this, &MainWindow::onEmitTimestampPathChanged);
+    emitPathLayout->addWidget(m_emitPathInput, 1);
+    eventStatsLayout->addLayout(emitPathLayout);
+
+    m_eventStatsTree = new QTreeWidget(eventStatsPanel);
+    m_eventStatsTree->setHeaderLabels({"Event", "Count", "1s /s", "10s /s", "60s /s", "Jitter",
+                                       "Emit\u2192recv p50", "p99", "Viewer p50", "p99"});
+    m_eventStatsTree->setRootIsDecorated(false);
+    m_eventStatsTree->setAlternatingRowColors(true);
+    m_eventStatsTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_eventStatsTree->setStyleSheet(
+        "QTreeWidget {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background-color: #1e1e1e;"
+        "  alternate-background-color: #252525;"
+        "  color: #e0e0e0;"
+        "}"
+        "QHeaderView::section {"
+        "  background-color: #2d2d2d;"
+        "  color: #b0b0b0;"
+        "  padding: 4px;"
+        "  border: none;"
+        "}"
+    );
+    eventStatsLayout->addWidget(m_eventStatsTree, 1);
+
+    m_eventLagLabel = new QLabel(eventStatsPanel);
+    m_eventLagLabel->setWordWrap(true);
+    m_eventLagLabel->setStyleSheet(
+        "QLabel {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  color: #888;"
+        "}"
+    );
+    eventStatsLayout->addWidget(m_eventLagLabel);
+
+    QSplitter* eventSplitter = new QSplitter(Qt::Horizontal, this);
+    eventSplitter->addWidget(m_eventLog);
+    eventSplitter->addWidget(eventStatsPanel);
+    eventSplitter->setStretchFactor(0, 3);
+    eventSplitter->setStretchFactor(1, 2);
+
     m_methodsTree = new QTreeWidget(this);
     m_methodsTree->setHeaderLabels({"Name", "Type", "Return Type", "Parameters"});
     m_methodsTree->setAlternatingRowColors(true);
@@ -211,7 +379,7 @@ void MainWindow::setupUi()
     );
 
     QSplitter* splitter = new QSplitter(Qt::Vertical, this);
-    splitter->addWidget(m_eventLog);
+    splitter->addWidget(eventSplitter);
     splitter->addWidget(m_methodsTree);
     splitter->setStretchFactor(0, 1);
     splitter->setStretchFactor(1, 2);
@@ -228,6 +396,75 @@ void MainWindow::setupUi()
     layout->addWidget(splitter);
 
     setCentralWidget(centralWidget);
+
+    m_loadTimeline = new LoadTimelineWidget(this);
+    m_loadTimeline->setLoader(m_session->graphLoader());
+    addPanelDock("Load Timeline", m_loadTimeline, Qt::BottomDockWidgetArea);
+
+    m_eventQueryPanel = new EventQueryPanel(&m_eventStore, this);
+    addPanelDock("Event Query", m_eventQueryPanel, Qt::BottomDockWidgetArea);
+
+    QWidget* resourcePanel = new QWidget(this);
+    QVBoxLayout* resourceLayout = new QVBoxLayout(resourcePanel);
+    resourceLayout->setContentsMargins(8, 8, 8, 8);
+    resourceLayout->setSpacing(6);
+    QHBoxLayout* resourceControls = new QHBoxLayout();
+    m_hostPidLabel = new QLabel(ProcessSampler::isSupported() ? "Host: -" : "Host monitoring needs /proc (Linux)", resourcePanel);
+    m_hostPidLabel->setStyleSheet("color: #888; font-size: 11px;");
+    resourceControls->addWidget(m_hostPidLabel, 1);
+    QSpinBox* sampleInterval = new QSpinBox(resourcePanel);
+    sampleInterval->setRange(50, 10000);
+    sampleInterval->setSingleStep(50);
+    sampleInterval->setValue(m_resourceMonitor->interval());
+    sampleInterval->setPrefix("every ");
+    sampleInterval->setSuffix(" ms");
+    sampleInterval->setToolTip("How often /proc is sampled");
+    sampleInterval->setStyleSheet(
+        "QSpinBox {"
+        "  padding: 4px 8px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "}"
+    );
+    connect(sampleInterval, &QSpinBox::valueChanged, m_resourceMonitor, &ResourceMonitor::setInterval);
+    resourceControls->addWidget(sampleInterval);
+    resourceLayout->addLayout(resourceControls);
+    m_resourceMonitorWidget = new ResourceMonitorWidget(resourcePanel);
+    m_resourceMonitorWidget->setMonitor(m_resourceMonitor);
+    resourceLayout->addWidget(m_resourceMonitorWidget, 1);
+    connect(m_resourceMonitor, &ResourceMonitor::pidsChanged, this, [this](const QList<int>& pids) {
+        m_metrics.setHostPids(pids);
+        QStringList pidStrings;
+        for (int pid : pids) {
+            pidStrings << QString::number(pid);
+        }
+        m_hostPidLabel->setText(pids.isEmpty()
+            ? QString("Host: not found")
+            : QString("logos_host pid %1 (%2 cores)").arg(pidStrings.join(", ")).arg(ProcessSampler::cpuCount()));
+    });
+    addPanelDock("Host Resources", resourcePanel, Qt::BottomDockWidgetArea);
+}
+
+QDockWidget* MainWindow::addPanelDock(const QString& title, QWidget* content, Qt::DockWidgetArea area)
+{
+    QDockWidget* dock = new QDockWidget(title, this);
+    dock->setObjectName(title);
+    dock->setWidget(content);
+    dock->setFeatures(QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable | QDockWidget::DockWidgetClosable);
+    dock->setStyleSheet(
+        "QDockWidget {"
+        "  color: #e0e0e0;"
+        "  font-weight: 600;"
+        "}"
+        "QDockWidget::title {"
+        "  background-color: #2d2d2d;"
+        "  padding: 6px 8px;"
+        "}"
+    );
+    addDockWidget(area, dock);
+    return dock;
 }
 
 QWidget* MainWindow::createMethodForm(const QMetaMethod& method, int methodIndex)
@@ -319,7 +556,33 @@ QWidget* MainWindow::createMethodForm(const QMetaMethod& method, int methodIndex
         QString labelText = QString("<b style='color: #e0e0e0;'>%1</b> <span style='color: #888;'>(%2)</span>").arg(paramName, paramType);
         QLabel* label = new QLabel(labelText);
         label->setStyleSheet("color: #e0e0e0;");
-        formLayout->addRow(label, inputWidget);
+
+        if (normalizedType == "QString" || normalizedType == "QByteArray") {
+            QWidget* field = new QWidget();
+            QHBoxLayout* fieldLayout = new QHBoxLayout(field);
+            fieldLayout->setContentsMargins(0, 0, 0, 0);
+            fieldLayout->setSpacing(6);
+            fieldLayout->addWidget(inputWidget);
+
+            QPushButton* fileButton = new QPushButton("File...");
+            fileButton->setProperty("paramWidget", QString("param_%1").arg(p));
+            fileButton->setToolTip("Use a file's contents as this argument (memory-mapped)");
+            fileButton->setStyleSheet(
+                "QPushButton {"
+                "  background-color: #3d3d3d;"
+                "  color: #e0e0e0;"
+                "  border: none;"
+                "  padding: 6px 10px;"
+                "  border-radius: 4px;"
+                "}"
+                "QPushButton:hover { background-color: #4d4d4d; }"
+            );
+            connect(fileButton, &QPushButton::clicked, this, &MainWindow::onChoosePayloadFile);
+            fieldLayout->addWidget(fileButton);
+            formLayout->addRow(label, field);
+        } else {
+            formLayout->addRow(label, inputWidget);
+        }
     }
 
     if (method.parameterCount() == 0) {
@@ -352,8 +615,117 @@ QWidget* MainWindow::createMethodForm(const QMetaMethod& method, int methodIndex
 
     buttonLayout->addWidget(callButton);
     buttonLayout->addStretch();
+
+    QSpinBox* watchInterval = new QSpinBox();
+    watchInterval->setObjectName("watchInterval");
+    watchInterval->setRange(10, 600000);
+    watchInterval->setValue(250);
+    watchInterval->setSingleStep(50);
+    watchInterval->setSuffix(" ms");
+    watchInterval->setToolTip("Polling interval for watch mode");
+    watchInterval->setStyleSheet(
+        "QSpinBox {"
+        "  padding: 6px 8px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "}"
+    );
+    buttonLayout->addWidget(watchInterval);
+
+    QPushButton* watchButton = new QPushButton("Watch");
+    watchButton->setObjectName("watchButton");
+    watchButton->setProperty("methodIndex", methodIndex);
+    watchButton->setCheckable(true);
+    watchButton->setToolTip("Call this method repeatedly with the current arguments");
+    watchButton->setStyleSheet(
+        "QPushButton {"
+        "  background-color: #3d3d3d;"
+        "  color: #e0e0e0;"
+        "  border: none;"
+        "  padding: 8px 16px;"
+        "  border-radius: 4px;"
+        "  font-weight: 600;"
+        "}"
+        "QPushButton:hover { background-color: #4d4d4d; }"
+        "QPushButton:checked { background-color: #c75; color: #ffffff; }"
+    );
+    connect(watchButton, &QPushButton::clicked, this, &MainWindow::onToggleWatch);
+    buttonLayout->addWidget(watchButton);
     mainLayout->addLayout(buttonLayout);
 
+    QHBoxLayout* compareLayout = new QHBoxLayout();
+    compareLayout->setSpacing(8);
+
+    QPushButton* compareButton = new QPushButton("Compare Local vs Remote");
+    compareButton->setObjectName("compareButton");
+    compareButton->setProperty("methodIndex", methodIndex);
+    compareButton->setToolTip("Call the in-process instance and the remote host N times each and report the IPC overhead");
+    compareButton->setStyleSheet(
+        "QPushButton {"
+        "  background-color: #3d3d3d;"
+        "  color: #e0e0e0;"
+        "  border: none;"
+        "  padding: 8px 16px;"
+        "  border-radius: 4px;"
+        "  font-weight: 600;"
+        "}"
+        "QPushButton:hover { background-color: #4d4d4d; }"
+    );
+    connect(compareButton, &QPushButton::clicked, this, &MainWindow::onCompareInvocation);
+    compareLayout->addWidget(compareButton);
+
+    QSpinBox* compareIterations = new QSpinBox();
+    compareIterations->setObjectName("compareIterations");
+    compareIterations->setRange(1, 100000);
+    compareIterations->setValue(100);
+    compareIterations->setPrefix("x ");
+    compareIterations->setToolTip("Number of timed calls on each side");
+    compareIterations->setStyleSheet(
+        "QSpinBox {"
+        "  padding: 6px 8px;"
+        "  border: 1px solid #4d4d4d;"
+        "  border-radius: 4px;"
+        "  background: #1e1e1e;"
+        "  color: #e0e0e0;"
+        "}"
+    );
+    compareLayout->addWidget(compareIterations);
+
+    bool hasPayloadParam = false;
+    for (int p = 0; p < method.parameterCount(); ++p) {
+        QByteArray type = method.parameterTypeName(p);
+        hasPayloadParam = hasPayloadParam || type == "QString" || type == "QByteArray";
+    }
+    if (hasPayloadParam) {
+        QPushButton* sweepButton = new QPushButton("Size Sweep");
+        sweepButton->setObjectName("sweepButton");
+        sweepButton->setProperty("methodIndex", methodIndex);
+        sweepButton->setToolTip("Call with payloads from 1 KB to 64 MB in the first string/bytes parameter");
+        sweepButton->setStyleSheet(
+            "QPushButton {"
+            "  background-color: #3d3d3d;"
+            "  color: #e0e0e0;"
+            "  border: none;"
+            "  padding: 8px 16px;"
+            "  border-radius: 4px;"
+            "  font-weight: 600;"
+            "}"
+            "QPushButton:hover { background-color: #4d4d4d; }"
+        );
+        connect(sweepButton, &QPushButton::clicked, this, &MainWindow::onPayloadSweep);
+        compareLayout->addWidget(sweepButton);
+    }
+
+    if (InvocationComparer::mayHaveSideEffects(method)) {
+        QLabel* sideEffectsLabel = new QLabel("<span style='color: #e0b050;'>may have side effects</span>");
+        sideEffectsLabel->setToolTip("Void return or a mutating name; comparing calls it 2N+2 times");
+        compareLayout->addWidget(sideEffectsLabel);
+    }
+    compareLayout->addStretch();
+    mainLayout->addLayout(compareLayout);
+
     QFrame* resultFrame = new QFrame();
     resultFrame->setObjectName("resultFrame");
     resultFrame->setMinimumHeight(100);
@@ -389,6 +761,40 @@ QWidget* MainWindow::createMethodForm(const QMetaMethod& method, int methodIndex
     );
     resultLayout->addWidget(resultLabel);
 
+    SparklineWidget* sparkline = new SparklineWidget();
+    sparkline->setObjectName("watchSparkline");
+    sparkline->hide();
+    resultLayout->addWidget(sparkline);
+
+    QLabel* watchStatsLabel = new QLabel();
+    watchStatsLabel->setObjectName("watchStatsLabel");
+    watchStatsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    watchStatsLabel->setStyleSheet(
+        "QLabel {"
+        "  color: #888;"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "}"
+    );
+    watchStatsLabel->hide();
+    resultLayout->addWidget(watchStatsLabel);
+
+    QLabel* compareLabel = new QLabel();
+    compareLabel->setObjectName("compareLabel");
+    compareLabel->setWordWrap(true);
+    compareLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    compareLabel->setStyleSheet(
+        "QLabel {"
+        "  padding: 8px;"
+        "  background-color: #252525;"
+        "  border-radius: 4px;"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "}"
+    );
+    compareLabel->hide();
+    resultLayout->addWidget(compareLabel);
+
     mainLayout->addWidget(resultFrame);
 
     return formContainer;
@@ -401,12 +807,7 @@ void MainWindow::onCallMethod()
 
     int methodIndex = button->property("methodIndex").toInt();
     
-    // Find the form container by traversing up the widget hierarchy
-    QWidget* formWidget = button->parentWidget();
-    while (formWidget && formWidget->objectName() != "methodFormContainer") {
-        formWidget = formWidget->parentWidget();
-    }
-    
+    QWidget* formWidget = findFormContainer(button);
     if (!formWidget) {
         std::cout << "Error: Could not find form container widget" << std::endl;
         return;
@@ -415,34 +816,18 @@ void MainWindow::onCallMethod()
     invokeMethod(methodIndex, formWidget);
 }
 
-void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
+QWidget* MainWindow::findFormContainer(QWidget* child) const
 {
-    if (!m_pluginInstance || !m_logosAPI) {
-        QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
-        if (resultLabel) {
-            resultLabel->setText("<span style='color: #ff6b6b;'><b>Error:</b> LogosAPI not initialized</span>");
-            resultLabel->update();
-        }
-        return;
-    }
-
-    const QMetaObject* metaObject = m_pluginInstance->metaObject();
-    QMetaMethod method = metaObject->method(methodIndex);
-
-    QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
-    if (!resultLabel) {
-        std::cout << "Error: Could not find resultLabel widget in formWidget: " << formWidget << std::endl;
-        std::cout << "Form widget objectName: " << formWidget->objectName().toStdString() << std::endl;
-        QList<QLabel*> allLabels = formWidget->findChildren<QLabel*>(Qt::FindChildrenRecursively);
-        std::cout << "Found " << allLabels.size() << " labels in form widget" << std::endl;
-        for (QLabel* label : allLabels) {
-            std::cout << "  Label objectName: " << label->objectName().toStdString() << std::endl;
-        }
-        return;
+    // Find the form container by traversing up the widget hierarchy
+    QWidget* formWidget = child ? child->parentWidget() : nullptr;
+    while (formWidget && formWidget->objectName() != "methodFormContainer") {
+        formWidget = formWidget->parentWidget();
     }
-    
-    std::cout << "Found resultLabel: " << resultLabel << ", text: " << resultLabel->text().toStdString() << std::endl;
+    return formWidget;
+}
 
+QVariantList MainWindow::collectMethodArgs(const QMetaMethod& method, QWidget* formWidget, QString* error)
+{
     QVariantList args;
     for (int p = 0; p < method.parameterCount(); ++p) {
         QString paramType = QString::fromUtf8(method.parameterTypeName(p));
@@ -503,7 +888,23 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
             }
         } else {
             QLineEdit* edit = qobject_cast<QLineEdit*>(inputWidget);
-            if (edit) {
+            QString payloadFile = edit ? edit->property("payloadFile").toString() : QString();
+            if (!payloadFile.isEmpty()) {
+                QString mapError;
+                QSharedPointer<MappedPayload> payload = mappedPayload(payloadFile, &mapError);
+                if (!payload) {
+                    *error = QString("Cannot read %1: %2").arg(payloadFile, mapError);
+                    return QVariantList();
+                }
+                if (normalizedType == "QByteArray") {
+                    args.append(payload->bytes());
+                } else {
+                    // QString needs UTF-16, so this one path has to copy.
+                    args.append(QString::fromUtf8(payload->bytes()));
+                }
+                std::cout << "Parameter " << p << " (file): " << payloadFile.toStdString()
+                          << ", " << payload->size() << " bytes" << std::endl;
+            } else if (edit) {
                 QString text = edit->text();
                 args.append(text);
                 std::cout << "Parameter " << p << " (string): " << text.toStdString() << std::endl;
@@ -512,6 +913,95 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
             }
         }
     }
+    return args;
+}
+
+QSharedPointer<MappedPayload> MainWindow::mappedPayload(const QString& path, QString* error)
+{
+    // Mappings stay alive until the next module load: arguments built from
+    // them wrap the mapped memory without copying, and a running watch may
+    // still hold such arguments after the field is cleared.
+    QSharedPointer<MappedPayload> payload = m_mappedPayloads.value(path);
+    if (payload) {
+        return payload;
+    }
+    payload.reset(new MappedPayload);
+    if (!payload->open(path, error)) {
+        return QSharedPointer<MappedPayload>();
+    }
+    m_mappedPayloads.insert(path, payload);
+    return payload;
+}
+
+void MainWindow::onChoosePayloadFile()
+{
+    QPushButton* button = qobject_cast<QPushButton*>(sender());
+    if (!button) return;
+
+    QWidget* formWidget = findFormContainer(button);
+    QLineEdit* edit = formWidget ? formWidget->findChild<QLineEdit*>(button->property("paramWidget").toString(), Qt::FindChildrenRecursively) : nullptr;
+    if (!edit) {
+        return;
+    }
+
+    if (!edit->property("payloadFile").toString().isEmpty()) {
+        edit->setProperty("payloadFile", QString());
+        edit->clear();
+        edit->setReadOnly(false);
+        button->setText("File...");
+        return;
+    }
+
+    QString path = QFileDialog::getOpenFileName(this, "Choose payload file");
+    if (path.isEmpty()) {
+        return;
+    }
+    QString error;
+    QSharedPointer<MappedPayload> payload = mappedPayload(path, &error);
+    if (!payload) {
+        QMessageBox::warning(this, "Cannot use file", QString("%1\n\n%2").arg(path, error));
+        return;
+    }
+    edit->setProperty("payloadFile", path);
+    edit->setText(QString("@%1 (%2)").arg(path, PayloadSweepChart::formatBytes(payload->size())));
+    edit->setReadOnly(true);
+    button->setText("Clear");
+}
+
+void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
+{
+    if (!m_pluginInstance || !m_connectionPool) {
+        QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
+        if (resultLabel) {
+            resultLabel->setText("<span style='color: #ff6b6b;'><b>Error:</b> LogosAPI not initialized</span>");
+            resultLabel->update();
+        }
+        return;
+    }
+
+    const QMetaObject* metaObject = m_pluginInstance->metaObject();
+    QMetaMethod method = metaObject->method(methodIndex);
+
+    QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
+    if (!resultLabel) {
+        std::cout << "Error: Could not find resultLabel widget in formWidget: " << formWidget << std::endl;
+        std::cout << "Form widget objectName: " << formWidget->objectName().toStdString() << std::endl;
+        QList<QLabel*> allLabels = formWidget->findChildren<QLabel*>(Qt::FindChildrenRecursively);
+        std::cout << "Found " << allLabels.size() << " labels in form widget" << std::endl;
+        for (QLabel* label : allLabels) {
+            std::cout << "  Label objectName: " << label->objectName().toStdString() << std::endl;
+        }
+        return;
+    }
+    
+    std::cout << "Found resultLabel: " << resultLabel << ", text: " << resultLabel->text().toStdString() << std::endl;
+
+    QString argsError;
+    QVariantList args = collectMethodArgs(method, formWidget, &argsError);
+    if (!argsError.isEmpty()) {
+        resultLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> %1</span>").arg(argsError.toHtmlEscaped()));
+        return;
+    }
 
     QString methodName = QString::fromUtf8(method.name());
     
@@ -521,14 +1011,31 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
     std::cout << "Invoking remote method: " << m_currentModuleName.toStdString() 
               << "." << methodName.toStdString() << " with " << args.size() << " args" << std::endl;
     
-    LogosAPIClient* client = m_logosAPI->getClient(m_currentModuleName);
+    double setupMs = 0.0;
+    LogosAPIClient* client = m_connectionPool->client(m_currentModuleName, &setupMs);
     if (!client) {
-        resultLabel->setText("<span style='color: #ff6b6b;'><b>Error:</b> Failed to get API client</span>");
+        m_metrics.recordCallError(m_currentModuleName, methodName);
+        resultLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> Failed to get API client (%1)</span>")
+            .arg(ConnectionPool::stateName(m_connectionPool->state(m_currentModuleName))));
         resultLabel->update();
         return;
     }
 
+    CallMarker marker;
+    marker.method = methodName;
+    marker.startMs = MonotonicClock::nowMs();
     QVariant result = client->invokeRemoteMethod(m_currentModuleName, methodName, args);
+    marker.endMs = MonotonicClock::nowMs();
+    marker.ok = result.isValid() || method.returnMetaType().id() == QMetaType::Void;
+    m_resourceMonitor->addCall(marker);
+    double callMs = marker.endMs - marker.startMs;
+    m_metrics.recordCall(m_currentModuleName, methodName, callMs, marker.ok);
+    QString timingHtml = QString("<br><span style='color: #888; font-size: 11px;'>setup %1 ms, call %2 ms, args %3, result %4</span>")
+        .arg(setupMs, 0, 'f', 2)
+        .arg(callMs, 0, 'f', 2)
+        .arg(PayloadSweepChart::formatBytes(PayloadProfiler::serializedSize(args)))
+        .arg(PayloadSweepChart::formatBytes(PayloadProfiler::serializedSize(result)));
+    std::cout << "Call timing: setup " << setupMs << " ms, call " << callMs << " ms" << std::endl;
     
     QString returnType = QString::fromUtf8(method.typeName());
     QString normalizedReturn = returnType;
@@ -538,7 +1045,7 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
     normalizedReturn = normalizedReturn.trimmed();
 
     if (normalizedReturn.isEmpty() || normalizedReturn == "void") {
-        resultLabel->setText("<span style='color: #5a9;'>Method called successfully (void return)</span>");
+        resultLabel->setText("<span style='color: #5a9;'>Method called successfully (void return)</span>" + timingHtml);
     } else {
         QString resultText = result.toString();
         if (resultText.isEmpty() && result.canConvert<QStringList>()) {
@@ -551,7 +1058,7 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
             resultText = "(empty or null result)";
         }
         std::cout << "Result: " << resultText.toStdString() << std::endl;
-        QString resultHtml = QString("<span style='color: #5a9;'><b>Result:</b></span> <span style='color: #e0e0e0;'>%1</span>").arg(resultText.toHtmlEscaped());
+        QString resultHtml = QString("<span style='color: #5a9;'><b>Result:</b></span> <span style='color: #e0e0e0;'>%1</span>").arg(resultText.toHtmlEscaped()) + timingHtml;
         resultLabel->setText(resultHtml);
         std::cout << "Set resultLabel text to: " << resultHtml.toStdString() << std::endl;
         std::cout << "resultLabel isVisible: " << resultLabel->isVisible() << ", isEnabled: " << resultLabel->isEnabled() << std::endl;
@@ -562,6 +1069,427 @@ void MainWindow::invokeMethod(int methodIndex, QWidget* formWidget)
     }
 }
 
+void MainWindow::onToggleWatch()
+{
+    QPushButton* button = qobject_cast<QPushButton*>(sender());
+    if (!button) return;
+
+    int methodIndex = button->property("methodIndex").toInt();
+    QWidget* formWidget = findFormContainer(button);
+    if (!formWidget) {
+        std::cout << "Error: Could not find form container widget" << std::endl;
+        return;
+    }
+
+    SparklineWidget* sparkline = formWidget->findChild<SparklineWidget*>("watchSparkline", Qt::FindChildrenRecursively);
+    QLabel* statsLabel = formWidget->findChild<QLabel*>("watchStatsLabel", Qt::FindChildrenRecursively);
+    QSpinBox* intervalSpin = formWidget->findChild<QSpinBox*>("watchInterval", Qt::FindChildrenRecursively);
+
+    if (m_watchers.contains(methodIndex)) {
+        m_watchers.take(methodIndex)->dispose();
+        button->setChecked(false);
+        button->setText("Watch");
+        if (intervalSpin) {
+            intervalSpin->setEnabled(true);
+        }
+        return;
+    }
+
+    if (!m_pluginInstance || !m_connectionPool) {
+        button->setChecked(false);
+        QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
+        if (resultLabel) {
+            resultLabel->setText("<span style='color: #ff6b6b;'><b>Error:</b> LogosAPI not initialized</span>");
+        }
+        return;
+    }
+
+    QMetaMethod method = m_pluginInstance->metaObject()->method(methodIndex);
+    QString argsError;
+    QVariantList args = collectMethodArgs(method, formWidget, &argsError);
+    if (!argsError.isEmpty()) {
+        button->setChecked(false);
+        QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
+        if (resultLabel) {
+            resultLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> %1</span>").arg(argsError.toHtmlEscaped()));
+        }
+        return;
+    }
+
+    MethodWatcher* watcher = new MethodWatcher(method, args, remoteInvoker(m_currentModuleName), 240, this);
+    if (intervalSpin) {
+        watcher->setInterval(intervalSpin->value());
+        intervalSpin->setEnabled(false);
+    }
+    m_watchers[methodIndex] = watcher;
+
+    if (sparkline) {
+        sparkline->setWatcher(watcher);
+        sparkline->show();
+    }
+    if (statsLabel) {
+        statsLabel->show();
+        connect(watcher, &MethodWatcher::sampleRecorded, statsLabel, [watcher, statsLabel]() {
+            const RingBuffer<WatchSample>& samples = watcher->samples();
+            double totalLatency = 0.0;
+            double maxLatency = 0.0;
+            for (int i = 0; i < samples.size(); ++i) {
+                totalLatency += samples.at(i).latencyMs;
+                maxLatency = qMax(maxLatency, samples.at(i).latencyMs);
+            }
+            QString lastValue = watcher->lastResult().toString();
+            if (lastValue.isEmpty()) {
+                lastValue = watcher->lastResult().isValid() ? QString("(%1)").arg(watcher->lastResult().typeName()) : "-";
+            }
+            statsLabel->setText(QString("last: %1 | latency last %2 ms, avg %3 ms, max %4 ms | calls %5, skipped %6, failed %7")
+                .arg(lastValue.left(64).toHtmlEscaped())
+                .arg(samples.last().latencyMs, 0, 'f', 2)
+                .arg(totalLatency / samples.size(), 0, 'f', 2)
+                .arg(maxLatency, 0, 'f', 2)
+                .arg(watcher->callCount())
+                .arg(watcher->skippedTicks())
+                .arg(watcher->failedCalls()));
+        });
+    }
+
+    button->setChecked(true);
+    button->setText("Stop Watch");
+    watcher->start();
+}
+
+MethodWatcher::Invoker MainWindow::remoteInvoker(const QString& moduleName)
+{
+    return [this, moduleName](const QString& methodName, const QVariantList& args, bool* ok) {
+        LogosAPIClient* client = m_connectionPool ? m_connectionPool->client(moduleName) : nullptr;
+        *ok = client != nullptr;
+        return client ? client->invokeRemoteMethod(moduleName, methodName, args) : QVariant();
+    };
+}
+
+void MainWindow::onCompareInvocation()
+{
+    QPushButton* button = qobject_cast<QPushButton*>(sender());
+    if (!button) return;
+
+    int methodIndex = button->property("methodIndex").toInt();
+    QWidget* formWidget = findFormContainer(button);
+    if (!formWidget) {
+        std::cout << "Error: Could not find form container widget" << std::endl;
+        return;
+    }
+
+    QLabel* compareLabel = formWidget->findChild<QLabel*>("compareLabel", Qt::FindChildrenRecursively);
+    QSpinBox* iterationsSpin = formWidget->findChild<QSpinBox*>("compareIterations", Qt::FindChildrenRecursively);
+    if (!compareLabel) {
+        return;
+    }
+    compareLabel->show();
+
+    if (!m_pluginInstance || !m_connectionPool) {
+        compareLabel->setText("<span style='color: #ff6b6b;'><b>Error:</b> LogosAPI not initialized</span>");
+        return;
+    }
+
+    QMetaMethod method = m_pluginInstance->metaObject()->method(methodIndex);
+    int iterations = iterationsSpin ? iterationsSpin->value() : 100;
+
+    if (InvocationComparer::mayHaveSideEffects(method)) {
+        QMessageBox::StandardButton answer = QMessageBox::warning(this, "Method may have side effects",
+            QString("%1 looks like it changes state (void return or mutating name).\n\n"
+                    "Comparing will call it %2 times on the in-process instance and %2 times on the remote host. Continue?")
+                .arg(QString::fromUtf8(method.methodSignature()))
+                .arg(iterations + 1),
+            QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if (answer != QMessageBox::Yes) {
+            return;
+        }
+    }
+
+    QString argsError;
+    QVariantList args = collectMethodArgs(method, formWidget, &argsError);
+    if (!argsError.isEmpty()) {
+        compareLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> %1</span>").arg(argsError.toHtmlEscaped()));
+        return;
+    }
+    compareLabel->setText(QString("<i style='color: #888;'>Running %1 local and %1 remote calls...</i>").arg(iterations));
+    button->setEnabled(false);
+    QCoreApplication::processEvents();
+
+    InvocationComparison comparison = InvocationComparer::compare(m_pluginInstance, method, args, iterations,
+                                                                  remoteInvoker(m_currentModuleName));
+    button->setEnabled(true);
+
+    if (!comparison.error.isEmpty()) {
+        compareLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> %1</span>").arg(comparison.error.toHtmlEscaped()));
+        return;
+    }
+
+    std::cout << "Compare " << comparison.methodName.toStdString() << " local: " << comparison.local.toString().toStdString()
+              << " remote: " << comparison.remote.toString().toStdString() << std::endl;
+
+    QString text = QString(
+        "<b style='color: #e0e0e0;'>IPC overhead per call:</b> <span style='color: #e0b050;'>%1 ms (median), %2 ms (mean)</span><br>"
+        "<span style='color: #5a9;'>local</span> %3<br>"
+        "<span style='color: #6bb;'>remote</span> %4")
+        .arg(comparison.overheadP50Ms(), 0, 'f', 3)
+        .arg(comparison.overheadMeanMs(), 0, 'f', 3)
+        .arg(comparison.local.toString().toHtmlEscaped())
+        .arg(comparison.remote.toString().toHtmlEscaped());
+    if (comparison.localFailures > 0 || comparison.remoteFailures > 0) {
+        text += QString("<br><span style='color: #ff6b6b;'>failures: local %1, remote %2</span>")
+            .arg(comparison.localFailures)
+            .arg(comparison.remoteFailures);
+    }
+    if (!comparison.resultsMatch) {
+        text += "<br><span style='color: #e0b050;'>Local and remote results differ; the in-process instance "
+                "is not initialised with LogosAPI and may not match the hosted one.</span>";
+    }
+    compareLabel->setText(text);
+}
+
+void MainWindow::onPayloadSweep()
+{
+    QPushButton* button = qobject_cast<QPushButton*>(sender());
+    if (!button) return;
+
+    int methodIndex = button->property("methodIndex").toInt();
+    QWidget* formWidget = findFormContainer(button);
+    if (!formWidget || !m_pluginInstance || !m_connectionPool) {
+        return;
+    }
+
+    QMetaMethod method = m_pluginInstance->metaObject()->method(methodIndex);
+    int paramIndex = -1;
+    bool asBytes = false;
+    for (int p = 0; p < method.parameterCount() && paramIndex < 0; ++p) {
+        QByteArray type = method.parameterTypeName(p);
+        if (type == "QString" || type == "QByteArray") {
+            paramIndex = p;
+            asBytes = type == "QByteArray";
+        }
+    }
+    if (paramIndex < 0) {
+        return;
+    }
+
+    const QVector<qint64> sizes = PayloadProfiler::defaultSweepSizes();
+    const int repetitions = 3;
+    if (InvocationComparer::mayHaveSideEffects(method)) {
+        QMessageBox::StandardButton answer = QMessageBox::warning(this, "Method may have side effects",
+            QString("%1 looks like it changes state (void return or mutating name).\n\n"
+                    "The sweep calls it %2 times with payloads up to %3. Continue?")
+                .arg(QString::fromUtf8(method.methodSignature()))
+                .arg(sizes.size() * repetitions)
+                .arg(PayloadSweepChart::formatBytes(sizes.last())),
+            QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if (answer != QMessageBox::Yes) {
+            return;
+        }
+    }
+
+    QString argsError;
+    QVariantList args = collectMethodArgs(method, formWidget, &argsError);
+    if (!argsError.isEmpty()) {
+        QLabel* resultLabel = formWidget->findChild<QLabel*>("resultLabel", Qt::FindChildrenRecursively);
+        if (resultLabel) {
+            resultLabel->setText(QString("<span style='color: #ff6b6b;'><b>Error:</b> %1</span>").arg(argsError.toHtmlEscaped()));
+        }
+        return;
+    }
+    QString methodName = QString::fromUtf8(method.name());
+
+    QDialog* dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QString("Payload sweep - %1").arg(methodName));
+    dialog->setStyleSheet("QDialog { background-color: #1e1e1e; color: #e0e0e0; }");
+    QVBoxLayout* dialogLayout = new QVBoxLayout(dialog);
+
+    QLabel* statusLabel = new QLabel(dialog);
+    statusLabel->setStyleSheet("color: #888;");
+    dialogLayout->addWidget(statusLabel);
+
+    PayloadSweepChart* chart = new PayloadSweepChart(dialog);
+    dialogLayout->addWidget(chart, 1);
+
+    QTreeWidget* table = new QTreeWidget(dialog);
+    table->setRootIsDecorated(false);
+    table->setHeaderLabels({"Payload", "Args", "Result", "p50 ms", "p99 ms", "MB/s", "Failures"});
+    table->setStyleSheet(
+        "QTreeWidget {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 12px;"
+        "  background-color: #252525;"
+        "  color: #e0e0e0;"
+        "  border: 1px solid #3d3d3d;"
+        "}"
+    );
+    dialogLayout->addWidget(table);
+    dialog->resize(720, 560);
+    dialog->show();
+
+    QPointer<QDialog> dialogGuard(dialog);
+    QPointer<QPushButton> buttonGuard(button);
+    button->setEnabled(false);
+    QVector<PayloadSweepPoint> points = PayloadProfiler::runSweep(methodName, args, paramIndex, asBytes,
+        method.returnMetaType().id() != QMetaType::Void, sizes, repetitions, remoteInvoker(m_currentModuleName),
+        [dialogGuard, statusLabel](qint64 payloadBytes, int index, int total) {
+            if (!dialogGuard) {
+                // Closing the dialog cancels the rest of the sweep.
+                return false;
+            }
+            statusLabel->setText(QString("Running %1 (%2 of %3)...")
+                .arg(PayloadSweepChart::formatBytes(payloadBytes))
+                .arg(index + 1)
+                .arg(total));
+            QCoreApplication::processEvents();
+            return !dialogGuard.isNull();
+        });
+    if (buttonGuard) {
+        buttonGuard->setEnabled(true);
+    }
+    if (!dialogGuard) {
+        return;
+    }
+
+    chart->setPoints(points);
+    for (const PayloadSweepPoint& point : points) {
+        QTreeWidgetItem* row = new QTreeWidgetItem(table);
+        row->setText(0, PayloadSweepChart::formatBytes(point.payloadBytes));
+        row->setText(1, PayloadSweepChart::formatBytes(point.argBytes));
+        row->setText(2, PayloadSweepChart::formatBytes(point.resultBytes));
+        row->setText(3, QString::number(point.latency.p50Ms, 'f', 3));
+        row->setText(4, QString::number(point.latency.p99Ms, 'f', 3));
+        row->setText(5, QString::number(point.throughputMBs(), 'f', 2));
+        row->setText(6, QString::number(point.failures));
+        std::cout << "Sweep " << methodName.toStdString() << " " << point.payloadBytes << " B: p50 "
+                  << point.latency.p50Ms << " ms, " << point.throughputMBs() << " MB/s" << std::endl;
+    }
+    statusLabel->setText(QString("%1 sizes, %2 calls each, parameter %3").arg(points.size()).arg(repetitions).arg(paramIndex));
+}
+
+void MainWindow::onCompareBuild()
+{
+    if (!m_pluginInstance) {
+        QMessageBox::information(this, "Compare Build", "Load a module first; it is the baseline of the comparison.");
+        return;
+    }
+    if (m_regressionRunner && m_regressionRunner->isRunning()) {
+        QMessageBox::information(this, "Compare Build", "A comparison is already running.");
+        return;
+    }
+
+    const QString baselinePath = m_session->modulePath();
+    const QString candidatePath = QFileDialog::getOpenFileName(this, "Select the build to compare against",
+        QFileInfo(baselinePath).absolutePath(), "Modules (*.so *.dylib *.dll);;All files (*)");
+    if (candidatePath.isEmpty()) {
+        return;
+    }
+
+    // The calls come from the forms as they are filled in now. Methods that
+    // may change state and file-backed payloads are left out.
+    QVector<BenchmarkCall> calls;
+    QStringList skipped;
+    for (auto it = m_itemToMethodIndex.constBegin(); it != m_itemToMethodIndex.constEnd(); ++it) {
+        QMetaMethod method = m_pluginInstance->metaObject()->method(it.value());
+        QString methodName = QString::fromUtf8(method.name());
+        QWidget* formWidget = it.key()->childCount() > 0 ? m_methodsTree->itemWidget(it.key()->child(0), 0) : nullptr;
+        if (!formWidget) {
+            continue;
+        }
+        bool usesPayloadFile = false;
+        for (QLineEdit* edit : formWidget->findChildren<QLineEdit*>()) {
+            usesPayloadFile = usesPayloadFile || !edit->property("payloadFile").toString().isEmpty();
+        }
+        if (InvocationComparer::mayHaveSideEffects(method) || usesPayloadFile) {
+            skipped << methodName;
+            continue;
+        }
+
+        BenchmarkCall call;
+        call.method = methodName;
+        QString argsError;
+        call.args = collectMethodArgs(method, formWidget, &argsError);
+        if (!argsError.isEmpty()) {
+            skipped << methodName;
+            continue;
+        }
+        QSpinBox* iterationsSpin = formWidget->findChild<QSpinBox*>("compareIterations", Qt::FindChildrenRecursively);
+        call.iterations = iterationsSpin ? iterationsSpin->value() : 100;
+        calls.append(call);
+    }
+    if (calls.isEmpty()) {
+        QMessageBox::information(this, "Compare Build", "There are no read-only methods to benchmark.");
+        return;
+    }
+
+    const QString callsPath = QDir(QDir::tempPath()).filePath(
+        QString("logos-module-viewer-calls-%1.json").arg(QCoreApplication::applicationPid()));
+    QString saveError;
+    if (!BenchmarkRunner::saveCalls(callsPath, calls, &saveError)) {
+        QMessageBox::warning(this, "Compare Build", QString("Cannot write the call file: %1").arg(saveError));
+        return;
+    }
+
+    QDialog* dialog = new QDialog(this);
+    dialog->setAttribute(Qt::WA_DeleteOnClose);
+    dialog->setWindowTitle(QString("Compare builds - %1").arg(m_currentModuleName));
+    dialog->setStyleSheet("QDialog { background-color: #1e1e1e; color: #e0e0e0; }");
+    QVBoxLayout* dialogLayout = new QVBoxLayout(dialog);
+    QPlainTextEdit* reportView = new QPlainTextEdit(dialog);
+    reportView->setReadOnly(true);
+    reportView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    reportView->setStyleSheet(
+        "QPlainTextEdit {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 12px;"
+        "  background-color: #252525;"
+        "  color: #e0e0e0;"
+        "  border: 1px solid #3d3d3d;"
+        "}"
+    );
+    dialogLayout->addWidget(reportView);
+    dialog->resize(960, 480);
+    dialog->show();
+
+    reportView->appendPlainText(QString("Benchmarking %1 calls; each build runs in its own process and host.").arg(calls.size()));
+    if (!skipped.isEmpty()) {
+        reportView->appendPlainText(QString("Skipped (may change state or use a payload file): %1").arg(skipped.join(", ")));
+    }
+
+    if (!m_regressionRunner) {
+        m_regressionRunner = new RegressionRunner(this);
+    }
+    m_regressionRunner->disconnect(this);
+    QPointer<QPlainTextEdit> viewGuard(reportView);
+    connect(m_regressionRunner, &RegressionRunner::progress, this, [viewGuard](const QString& message) {
+        if (viewGuard) {
+            viewGuard->appendPlainText(message);
+        }
+    });
+    connect(m_regressionRunner, &RegressionRunner::finished, this, [viewGuard, callsPath](const RegressionReport& report) {
+        QFile::remove(callsPath);
+        std::cout << report.toText().toStdString() << std::flush;
+        if (viewGuard) {
+            viewGuard->appendPlainText("");
+            viewGuard->appendPlainText(report.toText());
+        }
+    });
+
+    RegressionRunner::Options options;
+    options.baselinePath = baselinePath;
+    options.candidatePath = candidatePath;
+    options.callsPath = callsPath;
+    m_regressionRunner->start(options);
+}
+
+void MainWindow::stopAllWatchers()
+{
+    for (MethodWatcher* watcher : std::as_const(m_watchers)) {
+        watcher->dispose();
+    }
+    m_watchers.clear();
+}
+
 void MainWindow::onSubscribeEvent()
 {
     if (!m_eventNameInput) {
@@ -579,30 +1507,95 @@ void MainWindow::onSubscribeEvent()
         return;
     }
 
-    if (m_currentModuleName.isEmpty() || !m_logosAPI) {
+    if (m_currentModuleName.isEmpty() || !m_connectionPool) {
         appendEventToLog("Error", QVariantList() << "No module loaded or LogosAPI not initialized");
         return;
     }
 
-    LogosAPIClient* client = m_logosAPI->getClient(m_currentModuleName);
-    if (!client) {
-        appendEventToLog("Error", QVariantList() << QString("Failed to get API client for module: %1").arg(m_currentModuleName));
+    QObject* replica = m_connectionPool->replica(m_currentModuleName);
+    if (!replica) {
+        appendEventToLog("Error", QVariantList() << QString("Failed to get replica object for module: %1").arg(m_currentModuleName));
         return;
     }
 
-    QObject* replica = client->requestObject(m_currentModuleName);
-    if (!replica) {
-        appendEventToLog("Error", QVariantList() << QString("Failed to get replica object for module: %1").arg(m_currentModuleName));
+    if (!registerEventHandler(eventName, replica)) {
+        appendEventToLog("Error", QVariantList() << QString("Failed to get API client for module: %1").arg(m_currentModuleName));
         return;
     }
+    m_eventMetrics.ensure(eventName);
+    updateEventStats();
+    appendEventToLog("Info", QVariantList() << QString("Subscribed to event: %1").arg(eventName));
+    m_eventNameInput->clear();
+}
+
+bool MainWindow::registerEventHandler(const QString& eventName, QObject* replica)
+{
+    LogosAPIClient* client = m_connectionPool->client(m_currentModuleName);
+    if (!client) {
+        return false;
+    }
 
-    client->onEvent(replica, nullptr, eventName, [this](const QString& name, const QVariantList& data) {
-        appendEventToLog(name, data);
+    // The callback only queues the event; formatting and display happen in
+    // the pipeline so a busy module cannot stall the GUI thread.
+    client->onEvent(replica, nullptr, eventName, [this, moduleName = m_currentModuleName](const QString& name, const QVariantList& data) {
+        m_metrics.recordEvent(moduleName, name);
+        if (m_eventPipeline) {
+            m_eventPipeline->submit(name, data);
+        }
     });
-
     m_eventSubscriptions[eventName] = replica;
-    appendEventToLog("Info", QVariantList() << QString("Subscribed to event: %1").arg(eventName));
-    m_eventNameInput->clear();
+    return true;
+}
+
+void MainWindow::onConnectionStateChanged(const QString& moduleName, ConnectionPool::State state)
+{
+    m_metrics.setConnectionState(moduleName, state, m_connectionPool->reconnectCount(moduleName));
+
+    if (moduleName != m_currentModuleName || !m_connectionLabel) {
+        return;
+    }
+
+    QString color = "#888";
+    if (state == ConnectionPool::State::Connected) {
+        color = "#5a9";
+    } else if (state == ConnectionPool::State::Reconnecting) {
+        color = "#e0b050";
+    }
+    QString text = QString("Connection: %1").arg(ConnectionPool::stateName(state));
+    if (state == ConnectionPool::State::Connected) {
+        text += QString(" (setup %1 ms").arg(m_connectionPool->lastSetupMs(moduleName), 0, 'f', 2);
+        int reconnects = m_connectionPool->reconnectCount(moduleName);
+        if (reconnects > 0) {
+            text += QString(", %1 reconnects").arg(reconnects);
+        }
+        text += ")";
+    }
+    m_connectionLabel->setText(text);
+    m_connectionLabel->setStyleSheet(QString(
+        "QLabel {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  color: %1;"
+        "}").arg(color));
+}
+
+void MainWindow::onReplicaChanged(const QString& moduleName, QObject* replica)
+{
+    if (moduleName != m_currentModuleName) {
+        return;
+    }
+
+    // Subscriptions were made on the previous replica; move them over so
+    // events keep flowing after a reconnect.
+    const QStringList eventNames = m_eventSubscriptions.keys();
+    for (const QString& eventName : eventNames) {
+        if (!replica) {
+            m_eventSubscriptions[eventName] = nullptr;
+        } else if (m_eventSubscriptions.value(eventName) != replica) {
+            registerEventHandler(eventName, replica);
+            appendEventToLog("Info", QVariantList() << QString("Resubscribed to event: %1").arg(eventName));
+        }
+    }
 }
 
 void MainWindow::appendEventToLog(const QString& eventName, const QVariantList& data)
@@ -611,43 +1604,183 @@ void MainWindow::appendEventToLog(const QString& eventName, const QVariantList&
         return;
     }
 
-    QJsonObject eventObj;
-    eventObj["event"] = eventName;
-    eventObj["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-    
-    QJsonArray dataArray;
-    for (const QVariant& v : data) {
-        dataArray.append(QJsonValue::fromVariant(v));
+    m_eventLog->appendPlainText(EventPipeline::formatEvent(eventName, QDateTime::currentMSecsSinceEpoch(), data));
+    m_eventLog->verticalScrollBar()->setValue(m_eventLog->verticalScrollBar()->maximum());
+}
+
+void MainWindow::onEventBatch(const QVector<PipelineEvent>& batch)
+{
+    QString text;
+    for (const PipelineEvent& event : batch) {
+        m_eventStore.appendNormalized(event.name, event.timestampMs, event.data);
+        m_resourceMonitor->addEvent(event.receivedMs);
+        text += event.text;
     }
-    eventObj["data"] = dataArray;
 
-    QJsonDocument doc(eventObj);
-    QString jsonString = doc.toJson(QJsonDocument::Indented);
+    // One append per frame instead of one per event.
+    if (m_eventLog && !text.isEmpty()) {
+        if (text.endsWith('\n')) {
+            text.chop(1);
+        }
+        const double appendStartMs = MonotonicClock::nowMs();
+        QScrollBar* scrollBar = m_eventLog->verticalScrollBar();
+        const bool atBottom = scrollBar->value() >= scrollBar->maximum() - 4;
+        m_eventLog->appendPlainText(text);
+        if (atBottom) {
+            scrollBar->setValue(scrollBar->maximum());
+        }
+        m_eventMetrics.recordLogAppend(MonotonicClock::nowMs() - appendStartMs);
+    }
 
-    m_eventLog->append(jsonString);
-    
-    QTextCursor cursor = m_eventLog->textCursor();
-    cursor.movePosition(QTextCursor::End);
-    m_eventLog->setTextCursor(cursor);
+    const double displayedMs = MonotonicClock::nowMs();
+    for (const PipelineEvent& event : batch) {
+        m_eventMetrics.record(event.name, event.timestampMs, event.receivedMs, event.formattedMs, displayedMs,
+                              event.data);
+    }
+}
+
+void MainWindow::onOverflowPolicyChanged(int index)
+{
+    if (!m_overflowPolicyCombo || index < 0) {
+        return;
+    }
+    m_eventPipeline->setOverflowPolicy(m_overflowPolicyCombo->itemData(index).value<EventPipeline::OverflowPolicy>());
+    updateEventCounters();
+}
+
+void MainWindow::updateEventCounters()
+{
+    if (!m_eventCountersLabel || !m_eventPipeline) {
+        return;
+    }
+
+    const quint64 dropped = m_eventPipeline->droppedCount();
+    m_eventCountersLabel->setText(QString("Events: %1 received, %2 shown, %3 queued, %4 dropped (%5)")
+        .arg(m_eventPipeline->receivedCount())
+        .arg(m_eventPipeline->deliveredCount())
+        .arg(m_eventPipeline->pendingCount())
+        .arg(dropped)
+        .arg(EventPipeline::policyName(m_eventPipeline->overflowPolicy())));
+    const QString styleSheet = QString(
+        "QLabel {"
+        "  font-family: 'SF Mono', 'Menlo', 'Monaco', monospace;"
+        "  font-size: 11px;"
+        "  color: %1;"
+        "}").arg(dropped > 0 ? "#e0b050" : "#888");
+    if (m_eventCountersLabel->styleSheet() != styleSheet) {
+        m_eventCountersLabel->setStyleSheet(styleSheet);
+    }
+}
+
+void MainWindow::onEmitTimestampPathChanged()
+{
+    const QString path = m_emitPathInput->text().trimmed();
+    if (path == m_eventMetrics.emitTimestampPath()) {
+        return;
+    }
+    if (!m_eventMetrics.setEmitTimestampPath(path)) {
+        appendEventToLog("Error", QVariantList() << QString("Invalid emit timestamp path: %1").arg(path));
+        m_emitPathInput->setText(m_eventMetrics.emitTimestampPath());
+        return;
+    }
+    updateEventStats();
+}
+
+void MainWindow::updateEventStats()
+{
+    if (!m_eventStatsTree) {
+        return;
+    }
+
+    const double nowMs = MonotonicClock::nowMs();
+    const bool emitEnabled = !m_eventMetrics.emitTimestampPath().isEmpty();
+    auto ms = [](double v) { return QString::number(v, 'f', v < 10.0 ? 2 : 0); };
+
+    for (const QString& name : m_eventMetrics.names()) {
+        const EventTypeStats* stats = m_eventMetrics.stats(name);
+        QTreeWidgetItem* item = m_eventStatsItems.value(name);
+        if (!item) {
+            item = new QTreeWidgetItem(m_eventStatsTree);
+            item->setText(0, name);
+            for (int column = 1; column < m_eventStatsTree->columnCount(); ++column) {
+                item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+            }
+            m_eventStatsItems.insert(name, item);
+        }
+
+        item->setText(1, QString::number(stats->count));
+        item->setText(2, QString::number(stats->rate(1, nowMs), 'f', 0));
+        item->setText(3, QString::number(stats->rate(10, nowMs), 'f', 1));
+        item->setText(4, QString::number(stats->rate(60, nowMs), 'f', 1));
+        item->setText(5, stats->intervals > 1 ? ms(stats->intervalStddevMs()) : QString("-"));
+        const bool hasEmit = stats->emitLatency.count > 0;
+        item->setText(6, hasEmit ? ms(stats->emitLatency.percentile(0.5)) : QString("-"));
+        item->setText(7, hasEmit ? ms(stats->emitLatency.percentile(0.99)) : QString("-"));
+        const bool hasViewer = stats->viewerLatency.count > 0;
+        item->setText(8, hasViewer ? ms(stats->viewerLatency.percentile(0.5)) : QString("-"));
+        item->setText(9, hasViewer ? ms(stats->viewerLatency.percentile(0.99)) : QString("-"));
+
+        QString tooltip = QString("%1: %2 events, mean gap %3 ms, jitter %4 ms\n")
+            .arg(name).arg(stats->count).arg(ms(stats->intervalMeanMs)).arg(ms(stats->intervalStddevMs()));
+        if (emitEnabled) {
+            tooltip += QString("\nEmit \u2192 receive (transit jitter %1 ms, %2 without timestamp, %3 from the future):\n%4")
+                .arg(ms(stats->transitJitterMs)).arg(stats->missingEmitTimestamp).arg(stats->clockSkewed)
+                .arg(stats->emitLatency.toText());
+        }
+        tooltip += QString("\nReceive \u2192 formatted:\n%1\nFormatted \u2192 in the log:\n%2")
+            .arg(stats->queueLatency.toText(), stats->displayLatency.toText());
+        // Preformatted so the histogram bars line up.
+        item->setToolTip(0, "<pre>" + tooltip.trimmed().toHtmlEscaped() + "</pre>");
+        item->setForeground(6, QColor(stats->clockSkewed > 0 ? "#e0b050" : "#e0e0e0"));
+    }
+
+    // Where the lag is, for everything together: a high emit-to-receive
+    // time points at the module or transport, the other two at the viewer.
+    const EventTypeStats& total = m_eventMetrics.total();
+    if (total.count == 0) {
+        m_eventLagLabel->setText("Lag p50/p99: no events yet");
+        return;
+    }
+    QString lag = "Lag p50/p99: ";
+    if (total.emitLatency.count > 0) {
+        lag += QString("emit\u2192recv %1/%2 ms, ")
+            .arg(ms(total.emitLatency.percentile(0.5)), ms(total.emitLatency.percentile(0.99)));
+    } else if (emitEnabled) {
+        lag += "emit\u2192recv n/a (no timestamps), ";
+    }
+    lag += QString("formatting %1/%2 ms, to log %3/%4 ms, log append %5/%6 ms per frame")
+        .arg(ms(total.queueLatency.percentile(0.5)), ms(total.queueLatency.percentile(0.99)))
+        .arg(ms(total.displayLatency.percentile(0.5)), ms(total.displayLatency.percentile(0.99)))
+        .arg(ms(m_eventMetrics.logAppend().percentile(0.5)), ms(m_eventMetrics.logAppend().percentile(0.99)));
+    m_eventLagLabel->setText(lag);
 }
 
 void MainWindow::loadModule(const QString& path)
 {
+    stopAllWatchers();
     m_methodsTree->clear();
     m_itemToMethodIndex.clear();
+    m_mappedPayloads.clear();
 
     m_eventSubscriptions.clear();
+    m_eventPipeline->clear();
     if (m_eventLog) {
         m_eventLog->clear();
     }
-
-    if (m_pluginLoader) {
-        m_pluginLoader->unload();
-        delete m_pluginLoader;
-        m_pluginLoader = nullptr;
-        m_pluginInstance = nullptr;
+    m_eventStore.clear();
+    m_eventMetrics.clear();
+    m_eventStatsItems.clear();
+    // m_metrics keeps its series: scrapers expect counters to only go up.
+    // Releasing the module below reports its connection as disconnected.
+    if (m_eventStatsTree) {
+        m_eventStatsTree->clear();
     }
 
+    m_session->unload();
+    m_pluginInstance = nullptr;
+    m_resourceMonitor->stop();
+    m_resourceMonitor->setModuleName(QString());
+
     QFileInfo fileInfo(path);
     if (!fileInfo.exists()) {
         m_headerLabel->setText("<b style='color: #ff6b6b;'>Error:</b> Module file not found<br><span style='color: #888;'>" + path + "</span>");
@@ -666,51 +1799,18 @@ void MainWindow::loadModule(const QString& path)
         return;
     }
 
-    QString resolvedPath = fileInfo.canonicalFilePath();
-    if (resolvedPath.isEmpty()) {
-        resolvedPath = fileInfo.absoluteFilePath();
-    }
-
-    if (!m_coreInitialized) {
-        QString modulesDir = QDir::cleanPath(QCoreApplication::applicationDirPath() + "/../modules");
-        std::cout << "Setting modules directory to: " << modulesDir.toStdString() << std::endl;
-        logos_core_set_plugins_dir(modulesDir.toUtf8().constData());
-        logos_core_start();
-        std::cout << "Logos Core started" << std::endl;
-        m_coreInitialized = true;
-
-        m_logosAPI = new LogosAPI("module_viewer", this);
-        std::cout << "LogosAPI initialized" << std::endl;
-    }
-
-    // Extract module name from file name (e.g., "package_manager_plugin.dylib" -> "package_manager")
-    QString baseName = fileInfo.baseName();
-    if (baseName.endsWith("_plugin")) {
-        baseName.chop(7); // Remove "_plugin" suffix
+    if (!m_session->isCoreStarted()) {
+        m_session->startCore();
+        m_connectionPool = m_session->connectionPool();
+        connect(m_connectionPool, &ConnectionPool::stateChanged, this, &MainWindow::onConnectionStateChanged);
+        connect(m_connectionPool, &ConnectionPool::replicaChanged, this, &MainWindow::onReplicaChanged);
     }
-    m_currentModuleName = baseName;
-    std::cout << "Module name: " << m_currentModuleName.toStdString() << std::endl;
 
-    std::cout << "Processing plugin: " << resolvedPath.toStdString() << std::endl;
-    char* pluginName = logos_core_process_plugin(resolvedPath.toUtf8().constData());
-    if (pluginName) {
-        std::cout << "Plugin processed, name: " << pluginName << std::endl;
-        bool loaded = logos_core_load_plugin(pluginName);
-        if (loaded) {
-            std::cout << "Plugin loaded successfully via Logos Core" << std::endl;
-        } else {
-            std::cout << "Warning: Failed to load plugin via Logos Core" << std::endl;
-        }
-        free(pluginName);
-    } else {
-        std::cout << "Warning: Failed to process plugin via Logos Core" << std::endl;
-    }
-
-    m_pluginLoader = new QPluginLoader(resolvedPath, this);
-    m_pluginInstance = m_pluginLoader->instance();
-
-    if (!m_pluginInstance) {
-        m_headerLabel->setText("<b style='color: #ff6b6b;'>Error:</b> Failed to load module<br><span style='color: #888;'>" + m_pluginLoader->errorString() + "</span>");
+    // Known once the session has read the plugin's MetaData.
+    m_currentModuleName.clear();
+    QString loadError;
+    if (!m_session->load(path, &loadError)) {
+        m_headerLabel->setText("<b style='color: #ff6b6b;'>Error:</b> Failed to load module<br><span style='color: #888;'>" + loadError.toHtmlEscaped() + "</span>");
         m_headerLabel->setStyleSheet(
             "QLabel {"
             "  font-family: -apple-system, 'Segoe UI', sans-serif;"
@@ -723,14 +1823,16 @@ void MainWindow::loadModule(const QString& path)
             "  border-radius: 8px;"
             "}"
         );
-        delete m_pluginLoader;
-        m_pluginLoader = nullptr;
         return;
     }
+    m_pluginInstance = m_session->pluginInstance();
+    m_currentModuleName = m_session->moduleName();
+    m_resourceMonitor->setModuleName(m_currentModuleName);
+    m_resourceMonitor->start();
+    const QString resolvedPath = m_session->modulePath();
 
     QString moduleName;
-    QJsonObject metaData = m_pluginLoader->metaData();
-    QJsonObject meta = metaData.value("MetaData").toObject();
+    QJsonObject meta = m_session->metaData();
     moduleName = meta.value("name").toString();
     QString moduleVersion = meta.value("version").toString();
 
@@ -827,6 +1929,10 @@ void MainWindow::loadModule(const QString& path)
                 break;
         }
         item->setForeground(1, typeColor);
+        if (InvocationComparer::mayHaveSideEffects(method)) {
+            item->setToolTip(0, "May have side effects (void return or mutating name)");
+            item->setForeground(0, QColor("#e0b050"));
+        }
 
         QFont nameFont = item->font(0);
         nameFont.setBold(true);
@@ -853,5 +1959,14 @@ void MainWindow::loadModule(const QString& path)
         initLogosItem->setExpanded(false);
     }
     setWindowTitle(QString("Logos Module Viewer - %1").arg(moduleName));
+
+    // Set up the client and replica right away so the first call doesn't pay
+    // for it; deferred one turn so the method list paints first.
+    QString warmModule = m_currentModuleName;
+    QTimer::singleShot(0, this, [this, warmModule]() {
+        if (m_connectionPool && warmModule == m_currentModuleName) {
+            m_connectionPool->warmUp(warmModule);
+        }
+    });
 }
 
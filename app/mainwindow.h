@@ -5,16 +5,32 @@
 #include <QString>
 #include <QMap>
 #include <QVariant>
+#include <QSharedPointer>
+
+#include "connectionpool.h"
+#include "eventmetrics.h"
+#include "eventpipeline.h"
+#include "eventstore.h"
+#include "methodwatcher.h"
+#include "metricsregistry.h"
 
 class QTreeWidget;
 class QTreeWidgetItem;
 class QLabel;
-class QPluginLoader;
 class QWidget;
 class QMetaMethod;
-class LogosAPI;
 class QLineEdit;
-class QTextEdit;
+class QPlainTextEdit;
+class QComboBox;
+class QTimer;
+class MappedPayload;
+class ModuleSession;
+class LoadTimelineWidget;
+class EventQueryPanel;
+class QDockWidget;
+class RegressionRunner;
+class ResourceMonitor;
+class ResourceMonitorWidget;
 
 class MainWindow : public QMainWindow
 {
@@ -25,29 +41,71 @@ public:
     ~MainWindow();
 
     void loadModule(const QString& path);
+    // Call, event and connection statistics for export.
+    MetricsRegistry* metrics() { return &m_metrics; }
 
 private slots:
     void onCallMethod();
     void onSubscribeEvent();
+    void onToggleWatch();
+    void onCompareInvocation();
+    void onPayloadSweep();
+    void onChoosePayloadFile();
+    void onCompareBuild();
+    void onConnectionStateChanged(const QString& moduleName, ConnectionPool::State state);
+    void onReplicaChanged(const QString& moduleName, QObject* replica);
+    void onEventBatch(const QVector<PipelineEvent>& batch);
+    void onOverflowPolicyChanged(int index);
+    void updateEventCounters();
+    void updateEventStats();
+    void onEmitTimestampPathChanged();
 
 private:
     void setupUi();
+    QDockWidget* addPanelDock(const QString& title, QWidget* content, Qt::DockWidgetArea area);
     QWidget* createMethodForm(const QMetaMethod& method, int methodIndex);
+    QWidget* findFormContainer(QWidget* child) const;
+    // Sets *error, and the result should not be used, when a payload file
+    // chosen for an argument cannot be read.
+    QVariantList collectMethodArgs(const QMetaMethod& method, QWidget* formWidget, QString* error);
+    QSharedPointer<MappedPayload> mappedPayload(const QString& path, QString* error);
     void invokeMethod(int methodIndex, QWidget* formWidget);
+    MethodWatcher::Invoker remoteInvoker(const QString& moduleName);
+    void stopAllWatchers();
     void appendEventToLog(const QString& eventName, const QVariantList& data);
+    bool registerEventHandler(const QString& eventName, QObject* replica);
 
     QString m_modulePath;
     QString m_currentModuleName;
     QLabel* m_headerLabel;
     QTreeWidget* m_methodsTree;
-    QPluginLoader* m_pluginLoader;
+    ModuleSession* m_session;
     QObject* m_pluginInstance;
     QMap<QTreeWidgetItem*, int> m_itemToMethodIndex;
-    bool m_coreInitialized;
-    LogosAPI* m_logosAPI;
+    ConnectionPool* m_connectionPool;
+    QLabel* m_connectionLabel;
     QLineEdit* m_eventNameInput;
-    QTextEdit* m_eventLog;
+    QPlainTextEdit* m_eventLog;
+    QComboBox* m_overflowPolicyCombo;
+    QLabel* m_eventCountersLabel;
+    QTimer* m_eventCountersTimer;
+    EventPipeline* m_eventPipeline;
     QMap<QString, QObject*> m_eventSubscriptions;
+    EventMetrics m_eventMetrics;
+    MetricsRegistry m_metrics;
+    QLineEdit* m_emitPathInput;
+    QTreeWidget* m_eventStatsTree;
+    QLabel* m_eventLagLabel;
+    QHash<QString, QTreeWidgetItem*> m_eventStatsItems;
+    EventStore m_eventStore;
+    EventQueryPanel* m_eventQueryPanel;
+    LoadTimelineWidget* m_loadTimeline;
+    RegressionRunner* m_regressionRunner;
+    ResourceMonitor* m_resourceMonitor;
+    ResourceMonitorWidget* m_resourceMonitorWidget;
+    QLabel* m_hostPidLabel;
+    QMap<int, MethodWatcher*> m_watchers;
+    QHash<QString, QSharedPointer<MappedPayload>> m_mappedPayloads;
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,106 @@
+#include "methodwatcher.h"
+
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QDateTime>
+
+MethodWatcher::MethodWatcher(const QMetaMethod& method, const QVariantList& args, Invoker invoker,
+                             int capacity, QObject* parent)
+    : QObject(parent)
+    , m_methodName(QString::fromUtf8(method.name()))
+    , m_expectsResult(method.returnMetaType().id() != QMetaType::Void)
+    , m_args(args)
+    , m_invoker(std::move(invoker))
+    , m_timer(new QTimer(this))
+    , m_samples(capacity)
+    , m_inFlight(false)
+    , m_disposeWhenIdle(false)
+    , m_callCount(0)
+    , m_skippedTicks(0)
+    , m_failedCalls(0)
+{
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(250);
+    connect(m_timer, &QTimer::timeout, this, &MethodWatcher::onTick);
+}
+
+void MethodWatcher::setInterval(int intervalMs)
+{
+    m_timer->setInterval(qMax(1, intervalMs));
+}
+
+int MethodWatcher::interval() const
+{
+    return m_timer->interval();
+}
+
+void MethodWatcher::start()
+{
+    m_timer->start();
+    onTick();
+}
+
+void MethodWatcher::stop()
+{
+    m_timer->stop();
+}
+
+bool MethodWatcher::isRunning() const
+{
+    return m_timer->isActive();
+}
+
+void MethodWatcher::dispose()
+{
+    m_timer->stop();
+    if (m_inFlight) {
+        m_disposeWhenIdle = true;
+    } else {
+        deleteLater();
+    }
+}
+
+void MethodWatcher::onTick()
+{
+    // Remote calls block while spinning a nested event loop, so the timer can
+    // fire again before the previous call has returned.
+    if (m_inFlight) {
+        ++m_skippedTicks;
+        return;
+    }
+    m_inFlight = true;
+
+    WatchSample sample;
+    sample.timestampMs = QDateTime::currentMSecsSinceEpoch();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    bool ok = false;
+    QVariant result = m_invoker(m_methodName, m_args, &ok);
+    sample.latencyMs = elapsed.nsecsElapsed() / 1e6;
+    ++m_callCount;
+
+    sample.ok = ok && (!m_expectsResult || result.isValid());
+    if (!sample.ok) {
+        ++m_failedCalls;
+    } else if (m_expectsResult) {
+        bool numeric = false;
+        double value = result.toDouble(&numeric);
+        if (result.typeId() == QMetaType::Bool) {
+            value = result.toBool() ? 1.0 : 0.0;
+            numeric = true;
+        }
+        sample.numeric = numeric;
+        sample.value = numeric ? value : 0.0;
+        sample.changed = m_lastResult.isValid() && result != m_lastResult;
+        m_lastResult = result;
+    }
+
+    m_samples.push(sample);
+    m_inFlight = false;
+    if (m_disposeWhenIdle) {
+        deleteLater();
+        return;
+    }
+    emit sampleRecorded();
+}
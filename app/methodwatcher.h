@@ -0,0 +1,76 @@
+#ifndef METHODWATCHER_H
+#define METHODWATCHER_H
+
+#include <QObject>
+#include <QMetaMethod>
+#include <QString>
+#include <QVariant>
+#include <functional>
+
+#include "ringbuffer.h"
+
+class QTimer;
+
+struct WatchSample
+{
+    qint64 timestampMs = 0;
+    double latencyMs = 0.0;
+    double value = 0.0;
+    bool numeric = false;
+    bool changed = false;
+    bool ok = false;
+};
+
+// Calls one remote method on a fixed interval and keeps the most recent
+// results in a ring buffer. A tick that fires while the previous call is
+// still in flight is counted as skipped instead of queuing another call.
+class MethodWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Invoker = std::function<QVariant(const QString& methodName, const QVariantList& args, bool* ok)>;
+
+    MethodWatcher(const QMetaMethod& method, const QVariantList& args, Invoker invoker,
+                  int capacity = 240, QObject* parent = nullptr);
+
+    void setInterval(int intervalMs);
+    int interval() const;
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // Stops the watcher and deletes it once any in-flight call has returned.
+    void dispose();
+
+    QString methodName() const { return m_methodName; }
+    const RingBuffer<WatchSample>& samples() const { return m_samples; }
+    QVariant lastResult() const { return m_lastResult; }
+    quint64 callCount() const { return m_callCount; }
+    quint64 skippedTicks() const { return m_skippedTicks; }
+    quint64 failedCalls() const { return m_failedCalls; }
+
+signals:
+    void sampleRecorded();
+
+private slots:
+    void onTick();
+
+private:
+    QString m_methodName;
+    // False for void methods, whose calls return no value when they succeed.
+    bool m_expectsResult;
+    QVariantList m_args;
+    Invoker m_invoker;
+    QTimer* m_timer;
+    RingBuffer<WatchSample> m_samples;
+    QVariant m_lastResult;
+    bool m_inFlight;
+    bool m_disposeWhenIdle;
+    quint64 m_callCount;
+    quint64 m_skippedTicks;
+    quint64 m_failedCalls;
+};
+
+#endif // METHODWATCHER_H
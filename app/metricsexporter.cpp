@@ -0,0 +1,165 @@
+#include "metricsexporter.h"
+#include "metricsregistry.h"
+
+#include <QHostAddress>
+#include <QSaveFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+#include <iostream>
+
+namespace {
+
+// Requests are a single GET; anything bigger than this is not a scraper.
+const int kMaxRequestBytes = 8192;
+const int kRequestTimeoutMs = 5000;
+
+bool writeMetricsFile(MetricsRegistry* registry, const QString& path, QString* error)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    file.write(registry->render().toUtf8());
+    if (!file.commit()) {
+        *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void respond(QTcpSocket* socket, int status, const QByteArray& reason, const QByteArray& contentType,
+             const QByteArray& body, bool includeBody)
+{
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n"
+        + "Content-Type: " + contentType + "\r\n"
+        + "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+        + "Connection: close\r\n\r\n";
+    if (includeBody) {
+        response += body;
+    }
+    socket->setProperty("answered", true);
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+void serveMetrics(QTcpSocket* socket, MetricsRegistry* registry)
+{
+    QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    QTimer::singleShot(kRequestTimeoutMs, socket, [socket]() {
+        socket->abort();
+        socket->deleteLater();
+    });
+
+    QObject::connect(socket, &QTcpSocket::readyRead, socket, [socket, registry]() {
+        if (socket->property("answered").toBool()) {
+            socket->readAll();
+            return;
+        }
+        const QByteArray request = socket->property("request").toByteArray() + socket->readAll();
+        if (!request.contains("\r\n\r\n") && !request.contains("\n\n")) {
+            if (request.size() > kMaxRequestBytes) {
+                respond(socket, 431, "Request Header Fields Too Large", "text/plain", "", true);
+            } else {
+                socket->setProperty("request", request);
+            }
+            return;
+        }
+
+        const QList<QByteArray> requestLine = request.left(request.indexOf('\n')).trimmed().split(' ');
+        const QByteArray method = requestLine.value(0);
+        const QByteArray path = requestLine.value(1).split('?').value(0);
+        if (method != "GET" && method != "HEAD") {
+            respond(socket, 405, "Method Not Allowed", "text/plain", "Only GET is supported\n", true);
+        } else if (path != "/metrics" && path != "/") {
+            respond(socket, 404, "Not Found", "text/plain", "Metrics are at /metrics\n", method == "GET");
+        } else {
+            respond(socket, 200, "OK", MetricsRegistry::contentType().toUtf8(), registry->render().toUtf8(),
+                    method == "GET");
+        }
+    });
+}
+
+}
+
+MetricsExporter::MetricsExporter(MetricsRegistry* registry, QObject* parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_thread(new QThread())
+    , m_context(new QObject())
+{
+    m_thread->setObjectName("MetricsExporter");
+    m_context->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_context, &QObject::deleteLater);
+    m_thread->start();
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+bool MetricsExporter::startFile(const QString& path, int intervalMs, QString* error)
+{
+    bool ok = false;
+    QString writeError;
+    MetricsRegistry* registry = m_registry;
+    QObject* context = m_context;
+    QMetaObject::invokeMethod(m_context, [&]() {
+        ok = writeMetricsFile(registry, path, &writeError);
+        if (!ok) {
+            return;
+        }
+        QTimer* timer = new QTimer(context);
+        timer->setInterval(qMax(100, intervalMs));
+        // Warn once when writes start failing, not on every tick.
+        QObject::connect(timer, &QTimer::timeout, context, [registry, path, failing = false]() mutable {
+            QString tickError;
+            const bool written = writeMetricsFile(registry, path, &tickError);
+            if (!written && !failing) {
+                std::cout << "Warning: Cannot write metrics to " << path.toStdString() << ": "
+                          << tickError.toStdString() << std::endl;
+            }
+            failing = !written;
+        });
+        timer->start();
+    }, Qt::BlockingQueuedConnection);
+
+    if (!ok && error) {
+        *error = QString("Cannot write metrics to %1: %2").arg(path, writeError);
+    }
+    return ok;
+}
+
+bool MetricsExporter::startHttp(quint16 port, QString* error)
+{
+    bool ok = false;
+    QString listenError;
+    MetricsRegistry* registry = m_registry;
+    QObject* context = m_context;
+    QMetaObject::invokeMethod(m_context, [&]() {
+        QTcpServer* server = new QTcpServer(context);
+        if (!server->listen(QHostAddress::LocalHost, port)) {
+            listenError = server->errorString();
+            delete server;
+            return;
+        }
+        ok = true;
+        QObject::connect(server, &QTcpServer::newConnection, context, [server, registry]() {
+            while (QTcpSocket* socket = server->nextPendingConnection()) {
+                serveMetrics(socket, registry);
+            }
+        });
+    }, Qt::BlockingQueuedConnection);
+
+    if (ok) {
+        std::cout << "Serving metrics on http://127.0.0.1:" << port << "/metrics" << std::endl;
+    } else if (error) {
+        *error = QString("Cannot listen on 127.0.0.1:%1: %2").arg(port).arg(listenError);
+    }
+    return ok;
+}
@@ -0,0 +1,35 @@
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <QObject>
+#include <QString>
+
+class QThread;
+class MetricsRegistry;
+
+// Publishes a MetricsRegistry in OpenMetrics text format, by rewriting a
+// file on an interval and/or serving GET /metrics over HTTP on 127.0.0.1.
+// Rendering, file writes and the server all run on the exporter's own
+// thread, so a slow scraper or disk never stalls the GUI.
+class MetricsExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsExporter(MetricsRegistry* registry, QObject* parent = nullptr);
+    ~MetricsExporter();
+
+    // Writes the file right away, then every intervalMs (atomically, via
+    // QSaveFile). Fails if the file cannot be written.
+    bool startFile(const QString& path, int intervalMs, QString* error = nullptr);
+    // Listens on 127.0.0.1 only. Fails if the port cannot be bound.
+    bool startHttp(quint16 port, QString* error = nullptr);
+
+private:
+    MetricsRegistry* m_registry;
+    QThread* m_thread;
+    // Lives on m_thread; parent of the timer, server and sockets.
+    QObject* m_context;
+};
+
+#endif // METRICSEXPORTER_H
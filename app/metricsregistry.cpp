@@ -0,0 +1,184 @@
+#include "metricsregistry.h"
+#include "processsampler.h"
+
+#include <QCoreApplication>
+#include <QMutexLocker>
+
+namespace {
+
+QString escapeLabel(QString value)
+{
+    value.replace('\\', "\\\\");
+    value.replace('"', "\\\"");
+    value.replace('\n', "\\n");
+    return value;
+}
+
+QString labels(const QList<QPair<QString, QString>>& pairs)
+{
+    QStringList parts;
+    for (const auto& pair : pairs) {
+        parts << QString("%1=\"%2\"").arg(pair.first, escapeLabel(pair.second));
+    }
+    return "{" + parts.join(',') + "}";
+}
+
+void family(QString* out, const QString& name, const QString& type, const QString& help, const QString& unit = QString())
+{
+    *out += QString("# TYPE %1 %2\n").arg(name, type);
+    if (!unit.isEmpty()) {
+        *out += QString("# UNIT %1 %2\n").arg(name, unit);
+    }
+    *out += QString("# HELP %1 %2\n").arg(name, help);
+}
+
+QString number(double value)
+{
+    return QString::number(value, 'g', 12);
+}
+
+}
+
+void MetricsRegistry::recordCall(const QString& module, const QString& method, double durationMs, bool ok)
+{
+    QMutexLocker locker(&m_mutex);
+    CallMetrics& metrics = m_calls[qMakePair(module, method)];
+    ++metrics.calls;
+    if (!ok) {
+        ++metrics.errors;
+    }
+    metrics.duration.add(durationMs);
+}
+
+void MetricsRegistry::recordCallError(const QString& module, const QString& method)
+{
+    QMutexLocker locker(&m_mutex);
+    CallMetrics& metrics = m_calls[qMakePair(module, method)];
+    ++metrics.calls;
+    ++metrics.errors;
+}
+
+void MetricsRegistry::recordEvent(const QString& module, const QString& eventName)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_events[qMakePair(module, eventName)];
+}
+
+void MetricsRegistry::setConnectionState(const QString& module, ConnectionPool::State state, int reconnects)
+{
+    QMutexLocker locker(&m_mutex);
+    ConnectionMetrics& metrics = m_connections[module];
+    metrics.state = state;
+    if (reconnects < metrics.poolReconnects) {
+        metrics.poolReconnects = 0;
+    }
+    metrics.reconnects += reconnects - metrics.poolReconnects;
+    metrics.poolReconnects = reconnects;
+}
+
+void MetricsRegistry::setHostPids(const QList<int>& pids)
+{
+    QMutexLocker locker(&m_mutex);
+    m_hostPids = pids;
+}
+
+QString MetricsRegistry::contentType()
+{
+    return "application/openmetrics-text; version=1.0.0; charset=utf-8";
+}
+
+QString MetricsRegistry::render() const
+{
+    // Copy under the lock, format without it.
+    QMap<Key, CallMetrics> calls;
+    QMap<Key, quint64> events;
+    QMap<QString, ConnectionMetrics> connections;
+    QList<int> hostPids;
+    {
+        QMutexLocker locker(&m_mutex);
+        calls = m_calls;
+        events = m_events;
+        connections = m_connections;
+        hostPids = m_hostPids;
+    }
+
+    QString out;
+
+    family(&out, "logos_viewer_calls", "counter", "Remote method calls made by the viewer.");
+    for (auto it = calls.constBegin(); it != calls.constEnd(); ++it) {
+        out += QString("logos_viewer_calls_total%1 %2\n")
+            .arg(labels({{"module", it.key().first}, {"method", it.key().second}}))
+            .arg(it.value().calls);
+    }
+
+    family(&out, "logos_viewer_call_errors", "counter", "Remote method calls that failed or returned no result.");
+    for (auto it = calls.constBegin(); it != calls.constEnd(); ++it) {
+        out += QString("logos_viewer_call_errors_total%1 %2\n")
+            .arg(labels({{"module", it.key().first}, {"method", it.key().second}}))
+            .arg(it.value().errors);
+    }
+
+    family(&out, "logos_viewer_call_duration_seconds", "histogram", "Remote method call latency.", "seconds");
+    const QVector<double>& bounds = LatencyHistogram::boundsMs();
+    for (auto it = calls.constBegin(); it != calls.constEnd(); ++it) {
+        const LatencyHistogram& histogram = it.value().duration;
+        quint64 cumulative = 0;
+        for (int i = 0; i <= bounds.size(); ++i) {
+            cumulative += i < histogram.counts.size() ? histogram.counts.at(i) : 0;
+            const QString le = i < bounds.size() ? number(bounds.at(i) / 1000.0) : QString("+Inf");
+            out += QString("logos_viewer_call_duration_seconds_bucket%1 %2\n")
+                .arg(labels({{"module", it.key().first}, {"method", it.key().second}, {"le", le}}))
+                .arg(cumulative);
+        }
+        const QString callLabels = labels({{"module", it.key().first}, {"method", it.key().second}});
+        out += QString("logos_viewer_call_duration_seconds_count%1 %2\n").arg(callLabels).arg(histogram.count);
+        out += QString("logos_viewer_call_duration_seconds_sum%1 %2\n").arg(callLabels, number(histogram.sumMs / 1000.0));
+    }
+
+    family(&out, "logos_viewer_events_received", "counter", "Events received from subscriptions, before any are dropped.");
+    for (auto it = events.constBegin(); it != events.constEnd(); ++it) {
+        out += QString("logos_viewer_events_received_total%1 %2\n")
+            .arg(labels({{"module", it.key().first}, {"event", it.key().second}}))
+            .arg(it.value());
+    }
+
+    const QList<ConnectionPool::State> states = {
+        ConnectionPool::State::Disconnected,
+        ConnectionPool::State::Connecting,
+        ConnectionPool::State::Connected,
+        ConnectionPool::State::Reconnecting
+    };
+    family(&out, "logos_viewer_connection_state", "stateset", "State of the connection to the module's host.");
+    for (auto it = connections.constBegin(); it != connections.constEnd(); ++it) {
+        for (ConnectionPool::State state : states) {
+            out += QString("logos_viewer_connection_state%1 %2\n")
+                .arg(labels({{"module", it.key()}, {"logos_viewer_connection_state", ConnectionPool::stateName(state)}}))
+                .arg(it.value().state == state ? 1 : 0);
+        }
+    }
+
+    family(&out, "logos_viewer_reconnects", "counter", "Times the connection to the module's host was re-established.");
+    for (auto it = connections.constBegin(); it != connections.constEnd(); ++it) {
+        out += QString("logos_viewer_reconnects_total%1 %2\n").arg(labels({{"module", it.key()}})).arg(it.value().reconnects);
+    }
+
+    if (ProcessSampler::isSupported()) {
+        family(&out, "logos_viewer_resident_memory_bytes", "gauge", "Resident set size of the viewer and of the module's hosts.", "bytes");
+        ProcessCounters counters;
+        if (ProcessSampler::readCounters(static_cast<int>(QCoreApplication::applicationPid()), &counters)) {
+            out += QString("logos_viewer_resident_memory_bytes%1 %2\n").arg(labels({{"process", "viewer"}})).arg(counters.rssBytes);
+        }
+        if (!hostPids.isEmpty()) {
+            qint64 hostRss = 0;
+            for (int pid : std::as_const(hostPids)) {
+                if (ProcessSampler::readCounters(pid, &counters)) {
+                    hostRss += counters.rssBytes;
+                }
+            }
+            out += QString("logos_viewer_resident_memory_bytes%1 %2\n").arg(labels({{"process", "host"}})).arg(hostRss);
+        }
+    }
+
+    out += "# EOF\n";
+    return out;
+}
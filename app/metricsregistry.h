@@ -0,0 +1,58 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include "connectionpool.h"
+#include "latencystats.h"
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+// Call, event and connection statistics collected for export. Every method
+// is thread-safe and only holds the lock long enough to bump a counter, so
+// subscription callbacks and the GUI thread can record while an exporter
+// thread renders.
+class MetricsRegistry
+{
+public:
+    MetricsRegistry() = default;
+
+    void recordCall(const QString& module, const QString& method, double durationMs, bool ok);
+    // A call that never reached the module, e.g. because there was no client.
+    void recordCallError(const QString& module, const QString& method);
+    void recordEvent(const QString& module, const QString& eventName);
+    // reconnects is the pool's count, which starts over when a module is
+    // loaded again; the exported counter carries on from where it was.
+    void setConnectionState(const QString& module, ConnectionPool::State state, int reconnects);
+    // Hosts whose RSS is reported next to this process's.
+    void setHostPids(const QList<int>& pids);
+
+    // OpenMetrics text exposition, ending in "# EOF". Reads /proc for RSS,
+    // so call it off the GUI thread.
+    QString render() const;
+
+    static QString contentType();
+
+private:
+    struct CallMetrics {
+        quint64 calls = 0;
+        quint64 errors = 0;
+        LatencyHistogram duration;
+    };
+    struct ConnectionMetrics {
+        ConnectionPool::State state = ConnectionPool::State::Disconnected;
+        int reconnects = 0;
+        int poolReconnects = 0;
+    };
+    using Key = QPair<QString, QString>;
+
+    mutable QMutex m_mutex;
+    QMap<Key, CallMetrics> m_calls;
+    QMap<Key, quint64> m_events;
+    QMap<QString, ConnectionMetrics> m_connections;
+    QList<int> m_hostPids;
+};
+
+#endif // METRICSREGISTRY_H
@@ -0,0 +1,237 @@
+#include "modulegraphloader.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPluginLoader>
+#include <iostream>
+
+#include "logos_core.h"
+
+namespace {
+
+bool processAndLoadPlugin(const QString& path, QString* coreName, QString* error)
+{
+    char* pluginName = logos_core_process_plugin(path.toUtf8().constData());
+    if (!pluginName) {
+        *error = "Failed to process plugin via Logos Core";
+        return false;
+    }
+    // logos core does not say who owns the returned name or how it was
+    // allocated, so it is copied and left alone rather than freed.
+    *coreName = QString::fromUtf8(pluginName);
+    bool loaded = logos_core_load_plugin(pluginName);
+    if (!loaded) {
+        *error = "Failed to load plugin via Logos Core";
+    }
+    return loaded;
+}
+
+}
+
+ModuleGraphLoader::ModuleGraphLoader(QObject* parent)
+    : QObject(parent)
+    , m_rootIndex(-1)
+    , m_totalMs(0)
+{
+}
+
+QString ModuleGraphLoader::moduleNameForFile(const QFileInfo& fileInfo)
+{
+    QString baseName = fileInfo.baseName();
+    if (baseName.endsWith("_plugin")) {
+        baseName.chop(7); // Remove "_plugin" suffix
+    }
+    return baseName;
+}
+
+void ModuleGraphLoader::markUnloaded(const QString& coreName)
+{
+    for (auto it = m_loadedModules.begin(); it != m_loadedModules.end();) {
+        if (it.value() == coreName) {
+            it = m_loadedModules.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ModuleGraphLoader::readPluginInfo(const QString& path, PluginInfo* info)
+{
+    // metaData() reads the embedded JSON without loading the library.
+    QPluginLoader loader(path);
+    QJsonObject meta = loader.metaData().value("MetaData").toObject();
+    if (loader.metaData().isEmpty()) {
+        return false;
+    }
+    info->path = path;
+    info->name = meta.value("name").toString();
+    if (info->name.isEmpty()) {
+        info->name = moduleNameForFile(QFileInfo(path));
+    }
+    info->dependencies.clear();
+    const QJsonArray dependencies = meta.value("dependencies").toArray();
+    for (const QJsonValue& dependency : dependencies) {
+        QString name = dependency.toString().trimmed();
+        if (!name.isEmpty() && !info->dependencies.contains(name)) {
+            info->dependencies.append(name);
+        }
+    }
+    return true;
+}
+
+QHash<QString, ModuleGraphLoader::PluginInfo> ModuleGraphLoader::scanModulesDir(const QString& modulesDir) const
+{
+    QHash<QString, PluginInfo> plugins;
+    QDir dir(modulesDir);
+    const QFileInfoList files = dir.entryInfoList(QStringList() << "*.so" << "*.dylib" << "*.dll", QDir::Files);
+    for (const QFileInfo& file : files) {
+        PluginInfo info;
+        if (!readPluginInfo(file.absoluteFilePath(), &info)) {
+            continue;
+        }
+        plugins.insert(info.name, info);
+        // Dependencies are sometimes written as the file-derived name.
+        QString fileName = moduleNameForFile(file);
+        if (!plugins.contains(fileName)) {
+            plugins.insert(fileName, info);
+        }
+    }
+    return plugins;
+}
+
+bool ModuleGraphLoader::resolve(const QString& rootPath, const QString& modulesDir, QString* error)
+{
+    m_records.clear();
+    m_rootIndex = -1;
+
+    PluginInfo root;
+    if (!readPluginInfo(rootPath, &root)) {
+        root.name = moduleNameForFile(QFileInfo(rootPath));
+        root.path = rootPath;
+    }
+
+    QHash<QString, PluginInfo> available;
+    if (!root.dependencies.isEmpty()) {
+        available = scanModulesDir(modulesDir);
+    }
+
+    // Breadth-first walk from the root collects every reachable module.
+    QVector<PluginInfo> nodes;
+    QHash<QString, int> nodeIndex;
+    QStringList missing;
+    nodes.append(root);
+    nodeIndex.insert(root.name, 0);
+    for (int i = 0; i < nodes.size(); ++i) {
+        const QStringList dependencies = nodes.at(i).dependencies;
+        for (const QString& dependency : dependencies) {
+            if (nodeIndex.contains(dependency)) {
+                continue;
+            }
+            PluginInfo info = available.value(dependency);
+            if (info.path.isEmpty()) {
+                info.name = dependency;
+                missing.append(dependency);
+            }
+            nodeIndex.insert(dependency, nodes.size());
+            nodes.append(info);
+        }
+    }
+
+    // Kahn's algorithm: records end up in an order where every module comes
+    // after all of its dependencies.
+    QVector<int> inDegree(nodes.size(), 0);
+    QVector<QVector<int>> dependents(nodes.size());
+    for (int i = 0; i < nodes.size(); ++i) {
+        for (const QString& dependency : nodes.at(i).dependencies) {
+            int d = nodeIndex.value(dependency);
+            dependents[d].append(i);
+            ++inDegree[i];
+        }
+    }
+    QVector<int> order;
+    for (int i = 0; i < nodes.size(); ++i) {
+        if (inDegree.at(i) == 0) {
+            order.append(i);
+        }
+    }
+    for (int k = 0; k < order.size(); ++k) {
+        for (int dependent : dependents.at(order.at(k))) {
+            if (--inDegree[dependent] == 0) {
+                order.append(dependent);
+            }
+        }
+    }
+    if (order.size() != nodes.size()) {
+        QStringList cycle;
+        for (int i = 0; i < nodes.size(); ++i) {
+            if (inDegree.at(i) > 0) {
+                cycle.append(nodes.at(i).name);
+            }
+        }
+        if (error) {
+            *error = QString("Dependency cycle between: %1").arg(cycle.join(", "));
+        }
+        return false;
+    }
+
+    for (int k = 0; k < order.size(); ++k) {
+        const PluginInfo& info = nodes.at(order.at(k));
+        ModuleLoadRecord record;
+        record.name = info.name;
+        record.path = info.path;
+        record.dependencies = info.dependencies;
+        if (info.path.isEmpty()) {
+            record.error = QString("Not found in %1").arg(modulesDir);
+        }
+        m_records.append(record);
+    }
+    m_rootIndex = order.indexOf(0);
+
+    if (!missing.isEmpty() && error) {
+        *error = QString("Missing dependencies: %1").arg(missing.join(", "));
+    }
+    return true;
+}
+
+bool ModuleGraphLoader::load()
+{
+    QElapsedTimer clock;
+    clock.start();
+    m_totalMs = 0;
+
+    // Records are already in dependency order, so a plain walk loads every
+    // module after its dependencies.
+    bool allOk = true;
+    for (ModuleLoadRecord& record : m_records) {
+        record.startMs = clock.elapsed();
+        record.coreName.clear();
+        if (record.path.isEmpty() || m_loadedModules.contains(record.name)) {
+            record.endMs = record.startMs;
+            record.alreadyLoaded = !record.path.isEmpty();
+            record.ok = record.alreadyLoaded;
+            record.coreName = m_loadedModules.value(record.name);
+        } else {
+            std::cout << "Loading module " << record.name.toStdString() << " at +" << record.startMs << " ms" << std::endl;
+            emit moduleStarted(record.name);
+            record.alreadyLoaded = false;
+            record.error.clear();
+            record.ok = processAndLoadPlugin(record.path, &record.coreName, &record.error);
+            record.endMs = clock.elapsed();
+            std::cout << "Module " << record.name.toStdString() << (record.ok ? " loaded" : " failed") << " in "
+                      << (record.endMs - record.startMs) << " ms" << std::endl;
+        }
+        if (record.ok) {
+            m_loadedModules.insert(record.name, record.coreName);
+        }
+        allOk = allOk && record.ok;
+        emit moduleFinished(record.name, record.ok);
+    }
+
+    m_totalMs = clock.elapsed();
+    std::cout << "Module graph loaded in " << m_totalMs << " ms" << std::endl;
+    emit finished(allOk);
+    return allOk;
+}
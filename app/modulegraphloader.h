@@ -0,0 +1,83 @@
+#ifndef MODULEGRAPHLOADER_H
+#define MODULEGRAPHLOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+class QFileInfo;
+
+struct ModuleLoadRecord
+{
+    // From the plugin MetaData, or the file name if it has none.
+    QString name;
+    // Name logos core registered the module under; empty until loaded.
+    QString coreName;
+    QString path;
+    QStringList dependencies;
+    // Milliseconds since the start of ModuleGraphLoader::load(); -1 if not run.
+    qint64 startMs = -1;
+    qint64 endMs = -1;
+    bool ok = false;
+    bool alreadyLoaded = false;
+    QString error;
+};
+
+// Loads a module together with the modules it declares in the
+// "dependencies" array of its plugin MetaData, each one after its own
+// dependencies. Logos core is not documented as thread-safe and the objects
+// it creates take the affinity of the calling thread, so modules load one
+// at a time, in topological order, on the calling thread.
+class ModuleGraphLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModuleGraphLoader(QObject* parent = nullptr);
+
+    // Builds the graph rooted at rootPath, resolving dependency names
+    // against the plugins in modulesDir. Returns false on a cycle; missing
+    // dependencies are recorded as failed nodes and reported in *error.
+    bool resolve(const QString& rootPath, const QString& modulesDir, QString* error = nullptr);
+
+    // Loads the resolved graph and blocks until every node has finished;
+    // no events are processed meanwhile. Returns true if all nodes loaded.
+    bool load();
+
+    const QVector<ModuleLoadRecord>& records() const { return m_records; }
+    // Index in records() of the module passed to resolve(); -1 before that.
+    int rootIndex() const { return m_rootIndex; }
+    qint64 totalMs() const { return m_totalMs; }
+
+    // Forget that a module was loaded, e.g. after it has been unloaded.
+    // coreName is the name logos core registered it under.
+    void markUnloaded(const QString& coreName);
+
+    // "package_manager_plugin.dylib" -> "package_manager"
+    static QString moduleNameForFile(const QFileInfo& fileInfo);
+
+signals:
+    void moduleStarted(const QString& name);
+    void moduleFinished(const QString& name, bool ok);
+    void finished(bool ok);
+
+private:
+    struct PluginInfo {
+        QString name;
+        QString path;
+        QStringList dependencies;
+    };
+
+    static bool readPluginInfo(const QString& path, PluginInfo* info);
+    QHash<QString, PluginInfo> scanModulesDir(const QString& modulesDir) const;
+
+    QVector<ModuleLoadRecord> m_records;
+    int m_rootIndex;
+    // Record name -> name logos core registered the module under.
+    QHash<QString, QString> m_loadedModules;
+    qint64 m_totalMs;
+};
+
+#endif // MODULEGRAPHLOADER_H
@@ -0,0 +1,145 @@
+#include "moduleprobe.h"
+#include "connectionpool.h"
+#include "metricsregistry.h"
+#include "modulesession.h"
+#include "monotonicclock.h"
+#include "processsampler.h"
+#include "logos_api_client.h"
+
+#include <QMetaMethod>
+#include <QTimer>
+#include <iostream>
+
+namespace {
+// Hosts are only replaced by a reconnect; no need to look every round.
+const int kHostRefreshMs = 5000;
+}
+
+ModuleProbe::ModuleProbe(MetricsRegistry* registry, QObject* parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_session(new ModuleSession(this))
+    , m_timer(new QTimer(this))
+    , m_hostTimer(new QTimer(this))
+    , m_findingHosts(false)
+{
+    connect(m_timer, &QTimer::timeout, this, &ModuleProbe::runCalls);
+    m_hostTimer->setInterval(kHostRefreshMs);
+    connect(m_hostTimer, &QTimer::timeout, this, &ModuleProbe::refreshHostPids);
+}
+
+ModuleProbe::~ModuleProbe()
+{
+    m_timer->stop();
+    m_hostTimer->stop();
+    delete m_session;
+    m_session = nullptr;
+}
+
+bool ModuleProbe::start(const Options& options, QString* error)
+{
+    if (!options.callsPath.isEmpty()) {
+        QString loadError;
+        m_calls = BenchmarkRunner::loadCalls(options.callsPath, &loadError);
+        if (!loadError.isEmpty()) {
+            if (error) {
+                *error = loadError;
+            }
+            return false;
+        }
+    }
+
+    m_session->startCore();
+    ConnectionPool* pool = m_session->connectionPool();
+    connect(pool, &ConnectionPool::stateChanged, this, [this, pool](const QString& moduleName, ConnectionPool::State state) {
+        m_registry->setConnectionState(moduleName, state, pool->reconnectCount(moduleName));
+    });
+
+    if (!m_session->load(options.modulePath, error)) {
+        return false;
+    }
+    const QString moduleName = m_session->moduleName();
+    pool->warmUp(moduleName);
+
+    if (options.callsPath.isEmpty()) {
+        m_calls = BenchmarkRunner::defaultCalls(m_session->pluginInstance(), 1);
+    }
+    for (const BenchmarkCall& call : std::as_const(m_calls)) {
+        QMetaMethod method;
+        QVariantList args;
+        if (!BenchmarkRunner::prepareCall(m_session->pluginInstance(), call, &method, &args, error)) {
+            return false;
+        }
+    }
+
+    // Subscriptions are tied to a replica; make them again on the new one
+    // after a reconnect, the same way the window does.
+    auto subscribe = [this, moduleName, events = options.events](QObject* replica) {
+        LogosAPIClient* client = m_session->connectionPool()->client(moduleName);
+        if (!client || !replica) {
+            return;
+        }
+        MetricsRegistry* registry = m_registry;
+        for (const QString& eventName : events) {
+            client->onEvent(replica, nullptr, eventName, [registry, moduleName](const QString& name, const QVariantList&) {
+                registry->recordEvent(moduleName, name);
+            });
+        }
+    };
+    subscribe(pool->replica(moduleName));
+    connect(pool, &ConnectionPool::replicaChanged, this, [moduleName, subscribe](const QString& changedModule, QObject* replica) {
+        if (changedModule == moduleName) {
+            subscribe(replica);
+        }
+    });
+
+    std::cout << "Probing " << moduleName.toStdString() << ": " << m_calls.size() << " calls every "
+              << options.intervalMs << " ms, " << options.events.size() << " event subscriptions" << std::endl;
+    m_timer->setInterval(qMax(10, options.intervalMs));
+    m_timer->start();
+    m_hostTimer->start();
+    refreshHostPids();
+    runCalls();
+    return true;
+}
+
+void ModuleProbe::runCalls()
+{
+    if (!m_session || !m_session->isLoaded()) {
+        return;
+    }
+
+    const QString moduleName = m_session->moduleName();
+    for (const BenchmarkCall& call : std::as_const(m_calls)) {
+        QMetaMethod method;
+        QVariantList args;
+        if (!BenchmarkRunner::prepareCall(m_session->pluginInstance(), call, &method, &args)) {
+            m_registry->recordCallError(moduleName, call.method);
+            continue;
+        }
+        const bool expectsResult = method.returnMetaType().id() != QMetaType::Void;
+        for (int i = 0; i < call.iterations; ++i) {
+            bool ok = false;
+            const double startMs = MonotonicClock::nowMs();
+            const QVariant result = m_session->invokeRemote(call.method, args, &ok);
+            if (!ok) {
+                m_registry->recordCallError(moduleName, call.method);
+                continue;
+            }
+            m_registry->recordCall(moduleName, call.method, MonotonicClock::nowMs() - startMs,
+                                   !expectsResult || result.isValid());
+        }
+    }
+}
+
+void ModuleProbe::refreshHostPids()
+{
+    if (m_findingHosts || !m_session || !m_session->isLoaded()) {
+        return;
+    }
+    m_findingHosts = true;
+    ProcessSampler::findHostPidsAsync(m_session->moduleName(), this, [this](const QList<int>& pids) {
+        m_findingHosts = false;
+        m_registry->setHostPids(pids);
+    });
+}
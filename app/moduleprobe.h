@@ -0,0 +1,51 @@
+#ifndef MODULEPROBE_H
+#define MODULEPROBE_H
+
+#include "benchmarkrunner.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QTimer;
+class MetricsRegistry;
+class ModuleSession;
+
+// Headless stand-in for the window when the viewer runs as a long-lived
+// probe: loads a module, subscribes to events and repeats a set of calls on
+// a timer, recording everything into a MetricsRegistry for export.
+class ModuleProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString modulePath;
+        // Call file as used by --compare (iterations = calls per round);
+        // empty calls each read-only method without parameters once.
+        QString callsPath;
+        QStringList events;
+        int intervalMs = 1000;
+    };
+
+    explicit ModuleProbe(MetricsRegistry* registry, QObject* parent = nullptr);
+    ~ModuleProbe();
+
+    bool start(const Options& options, QString* error = nullptr);
+
+private:
+    void runCalls();
+    void refreshHostPids();
+
+    MetricsRegistry* m_registry;
+    ModuleSession* m_session;
+    QTimer* m_timer;
+    // Finding the host means a walk over /proc, so it runs on its own,
+    // slower timer and off this thread.
+    QTimer* m_hostTimer;
+    bool m_findingHosts;
+    QVector<BenchmarkCall> m_calls;
+};
+
+#endif // MODULEPROBE_H
@@ -0,0 +1,164 @@
+#include "modulesession.h"
+#include "connectionpool.h"
+#include "modulegraphloader.h"
+#include "logos_api.h"
+#include "logos_api_client.h"
+#include "logos_core.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QPluginLoader>
+#include <iostream>
+
+ModuleSession::ModuleSession(QObject* parent)
+    : QObject(parent)
+    , m_coreStarted(false)
+    , m_loadedInCore(false)
+    , m_logosAPI(nullptr)
+    , m_connectionPool(nullptr)
+    , m_graphLoader(new ModuleGraphLoader(this))
+    , m_pluginLoader(nullptr)
+    , m_pluginInstance(nullptr)
+{
+}
+
+ModuleSession::~ModuleSession()
+{
+    unload();
+    delete m_connectionPool;
+    m_connectionPool = nullptr;
+    delete m_logosAPI;
+    m_logosAPI = nullptr;
+    if (m_coreStarted) {
+        logos_core_cleanup();
+    }
+}
+
+void ModuleSession::startCore()
+{
+    if (m_coreStarted) {
+        return;
+    }
+
+    m_modulesDir = QDir::cleanPath(QCoreApplication::applicationDirPath() + "/../modules");
+    std::cout << "Setting modules directory to: " << m_modulesDir.toStdString() << std::endl;
+    logos_core_set_plugins_dir(m_modulesDir.toUtf8().constData());
+    logos_core_start();
+    std::cout << "Logos Core started" << std::endl;
+    m_coreStarted = true;
+
+    m_logosAPI = new LogosAPI("module_viewer", this);
+    std::cout << "LogosAPI initialized" << std::endl;
+
+    m_connectionPool = new ConnectionPool(m_logosAPI, this);
+}
+
+bool ModuleSession::load(const QString& path, QString* error)
+{
+    unload();
+
+    QFileInfo fileInfo(path);
+    if (!fileInfo.exists()) {
+        if (error) {
+            *error = QString("Module file not found: %1").arg(path);
+        }
+        return false;
+    }
+
+    QString resolvedPath = fileInfo.canonicalFilePath();
+    if (resolvedPath.isEmpty()) {
+        resolvedPath = fileInfo.absoluteFilePath();
+    }
+
+    startCore();
+
+    m_modulePath = resolvedPath;
+
+    std::cout << "Resolving dependencies of: " << resolvedPath.toStdString() << std::endl;
+    QString graphError;
+    if (!m_graphLoader->resolve(resolvedPath, m_modulesDir, &graphError)) {
+        std::cout << "Error: " << graphError.toStdString() << std::endl;
+        if (error) {
+            *error = QString("Cannot load module dependencies: %1").arg(graphError);
+        }
+        return false;
+    }
+    if (!graphError.isEmpty()) {
+        std::cout << "Warning: " << graphError.toStdString() << std::endl;
+    }
+    // The MetaData name until logos core says what it registered the module
+    // as; file names ("foo_plugin.so") need not match either.
+    m_moduleName = m_graphLoader->records().at(m_graphLoader->rootIndex()).name;
+    emit dependenciesResolved(m_graphLoader->records().size() - 1);
+    const bool loaded = m_graphLoader->load();
+    const ModuleLoadRecord& root = m_graphLoader->records().at(m_graphLoader->rootIndex());
+    if (!root.coreName.isEmpty()) {
+        m_moduleName = root.coreName;
+    }
+    std::cout << "Module name: " << m_moduleName.toStdString() << std::endl;
+    // Only a module this session loaded is unloaded again; one that was
+    // already there as another module's dependency stays.
+    m_loadedInCore = root.ok && !root.alreadyLoaded;
+    if (!loaded) {
+        for (const ModuleLoadRecord& record : m_graphLoader->records()) {
+            if (!record.ok) {
+                std::cout << "Warning: " << record.name.toStdString() << ": " << record.error.toStdString() << std::endl;
+            }
+        }
+    }
+
+    m_pluginLoader = new QPluginLoader(resolvedPath, this);
+    m_pluginInstance = m_pluginLoader->instance();
+    if (!m_pluginInstance) {
+        if (error) {
+            *error = m_pluginLoader->errorString();
+        }
+        delete m_pluginLoader;
+        m_pluginLoader = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ModuleSession::unload()
+{
+    if (m_connectionPool && !m_moduleName.isEmpty()) {
+        m_connectionPool->release(m_moduleName);
+    }
+    if (m_pluginLoader) {
+        m_pluginLoader->unload();
+        delete m_pluginLoader;
+        m_pluginLoader = nullptr;
+        m_pluginInstance = nullptr;
+    }
+
+    // Stop the module's host too, so loading it again starts from scratch
+    // instead of piling up on the previous instance. Dependencies stay
+    // loaded; the next module may well need them.
+    if (m_coreStarted && m_loadedInCore) {
+        std::cout << "Unloading from Logos Core: " << m_moduleName.toStdString() << std::endl;
+        if (!logos_core_unload_plugin(m_moduleName.toUtf8().constData())) {
+            std::cout << "Warning: Failed to unload " << m_moduleName.toStdString() << " from Logos Core" << std::endl;
+        }
+        m_graphLoader->markUnloaded(m_moduleName);
+        m_loadedInCore = false;
+    }
+}
+
+QJsonObject ModuleSession::metaData() const
+{
+    if (!m_pluginLoader) {
+        return QJsonObject();
+    }
+    return m_pluginLoader->metaData().value("MetaData").toObject();
+}
+
+QVariant ModuleSession::invokeRemote(const QString& methodName, const QVariantList& args, bool* ok)
+{
+    LogosAPIClient* client = m_connectionPool && isLoaded() ? m_connectionPool->client(m_moduleName) : nullptr;
+    if (ok) {
+        *ok = client != nullptr;
+    }
+    return client ? client->invokeRemoteMethod(m_moduleName, methodName, args) : QVariant();
+}
@@ -0,0 +1,71 @@
+#ifndef MODULESESSION_H
+#define MODULESESSION_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QString>
+#include <QVariant>
+
+class QPluginLoader;
+class LogosAPI;
+class ConnectionPool;
+class ModuleGraphLoader;
+
+// Everything needed to talk to one module: logos core, the module's
+// dependency graph, the in-process plugin instance used to read its
+// methods, and the LogosAPI client/replica pool used to call it remotely.
+// Logos core is process-wide, so a process holds at most one session.
+class ModuleSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModuleSession(QObject* parent = nullptr);
+    ~ModuleSession();
+
+    // Starts logos core against the modules directory next to the binary
+    // and creates the API and connection pool. Does nothing if already started.
+    void startCore();
+    bool isCoreStarted() const { return m_coreStarted; }
+
+    // Loads the module's dependencies through logos core, then the module
+    // itself in process. Any previously loaded module is unloaded first.
+    bool load(const QString& path, QString* error = nullptr);
+    // Releases the module's replica, unloads the in-process plugin and
+    // unloads the module (not its dependencies) from logos core.
+    void unload();
+
+    bool isLoaded() const { return m_pluginInstance != nullptr; }
+    QString modulePath() const { return m_modulePath; }
+    // Name the module is registered under in logos core.
+    QString moduleName() const { return m_moduleName; }
+    // The MetaData object of the plugin (name, version, dependencies, ...).
+    QJsonObject metaData() const;
+    QObject* pluginInstance() const { return m_pluginInstance; }
+
+    QString modulesDir() const { return m_modulesDir; }
+    LogosAPI* logosAPI() const { return m_logosAPI; }
+    ConnectionPool* connectionPool() const { return m_connectionPool; }
+    ModuleGraphLoader* graphLoader() const { return m_graphLoader; }
+
+    // Calls a method of the loaded module through its host.
+    QVariant invokeRemote(const QString& methodName, const QVariantList& args, bool* ok = nullptr);
+
+signals:
+    // Emitted after the dependency graph is resolved, before anything loads.
+    void dependenciesResolved(int dependencyCount);
+
+private:
+    bool m_coreStarted;
+    bool m_loadedInCore;
+    QString m_modulesDir;
+    QString m_modulePath;
+    QString m_moduleName;
+    LogosAPI* m_logosAPI;
+    ConnectionPool* m_connectionPool;
+    ModuleGraphLoader* m_graphLoader;
+    QPluginLoader* m_pluginLoader;
+    QObject* m_pluginInstance;
+};
+
+#endif // MODULESESSION_H
@@ -0,0 +1,33 @@
+#ifndef MONOTONICCLOCK_H
+#define MONOTONICCLOCK_H
+
+#include <QElapsedTimer>
+
+// Process-wide monotonic time base. Calls, events and resource samples are
+// all stamped with it so they can be drawn on one timeline; unlike wall
+// clock time it never jumps.
+namespace MonotonicClock {
+
+inline const QElapsedTimer& timer()
+{
+    static const QElapsedTimer started = []() {
+        QElapsedTimer t;
+        t.start();
+        return t;
+    }();
+    return started;
+}
+
+inline qint64 nowNs()
+{
+    return timer().nsecsElapsed();
+}
+
+inline double nowMs()
+{
+    return timer().nsecsElapsed() / 1e6;
+}
+
+}
+
+#endif // MONOTONICCLOCK_H
@@ -0,0 +1,153 @@
+#include "payloadprofiler.h"
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QIODevice>
+
+namespace {
+
+// Sink that only counts what QDataStream writes into it.
+class ByteCountingDevice : public QIODevice
+{
+public:
+    ByteCountingDevice() { open(QIODevice::WriteOnly); }
+
+    qint64 count() const { return m_count; }
+
+protected:
+    qint64 readData(char*, qint64) override { return -1; }
+    qint64 writeData(const char*, qint64 len) override
+    {
+        m_count += len;
+        return len;
+    }
+
+private:
+    qint64 m_count = 0;
+};
+
+}
+
+MappedPayload::~MappedPayload()
+{
+    if (m_data) {
+        m_file.unmap(m_data);
+    }
+}
+
+bool MappedPayload::open(const QString& path, QString* error)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error) {
+            *error = m_file.errorString();
+        }
+        return false;
+    }
+    m_size = m_file.size();
+    if (m_size == 0) {
+        return true;
+    }
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        if (error) {
+            *error = QString("mmap failed: %1").arg(m_file.errorString());
+        }
+        m_size = 0;
+        return false;
+    }
+    return true;
+}
+
+QByteArray MappedPayload::bytes() const
+{
+    if (!m_data) {
+        return QByteArray();
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(m_data), m_size);
+}
+
+double PayloadSweepPoint::throughputMBs() const
+{
+    if (latency.p50Ms <= 0.0) {
+        return 0.0;
+    }
+    return (argBytes + resultBytes) / (1024.0 * 1024.0) / (latency.p50Ms / 1000.0);
+}
+
+qint64 PayloadProfiler::serializedSize(const QVariant& value)
+{
+    ByteCountingDevice device;
+    QDataStream stream(&device);
+    stream << value;
+    return device.count();
+}
+
+qint64 PayloadProfiler::serializedSize(const QVariantList& values)
+{
+    ByteCountingDevice device;
+    QDataStream stream(&device);
+    stream << values;
+    return device.count();
+}
+
+QVector<qint64> PayloadProfiler::defaultSweepSizes()
+{
+    QVector<qint64> sizes;
+    for (qint64 size = 1024; size <= 64LL * 1024 * 1024; size *= 4) {
+        sizes.append(size);
+    }
+    return sizes;
+}
+
+QVariant PayloadProfiler::makePayload(qint64 bytes, bool asBytes)
+{
+    if (asBytes) {
+        return QByteArray(static_cast<int>(bytes), 'x');
+    }
+    // QDataStream writes QString as UTF-16, two bytes per character.
+    return QString(static_cast<int>(bytes / 2), QLatin1Char('x'));
+}
+
+QVector<PayloadSweepPoint> PayloadProfiler::runSweep(const QString& methodName, QVariantList args, int paramIndex,
+                                                     bool asBytes, bool expectsResult, const QVector<qint64>& sizes, int repetitions,
+                                                     const RemoteInvoker& remoteInvoker,
+                                                     const ProgressCallback& progress)
+{
+    QVector<PayloadSweepPoint> points;
+    if (paramIndex < 0 || paramIndex >= args.size()) {
+        return points;
+    }
+
+    for (int i = 0; i < sizes.size(); ++i) {
+        if (progress && !progress(sizes.at(i), i, sizes.size())) {
+            break;
+        }
+
+        PayloadSweepPoint point;
+        point.payloadBytes = sizes.at(i);
+        args[paramIndex] = makePayload(point.payloadBytes, asBytes);
+        point.argBytes = serializedSize(args);
+
+        QVector<double> samples;
+        QElapsedTimer timer;
+        for (int r = 0; r < qMax(1, repetitions); ++r) {
+            bool ok = false;
+            timer.start();
+            QVariant result = remoteInvoker(methodName, args, &ok);
+            double elapsedMs = timer.nsecsElapsed() / 1e6;
+            if (!ok || (expectsResult && !result.isValid())) {
+                ++point.failures;
+                continue;
+            }
+            samples.append(elapsedMs);
+            point.resultBytes = serializedSize(result);
+        }
+        point.latency = LatencySummary::fromSamples(samples);
+        points.append(point);
+
+        // Release the payload before building the next, larger one.
+        args[paramIndex] = QVariant();
+    }
+    return points;
+}
@@ -0,0 +1,74 @@
+#ifndef PAYLOADPROFILER_H
+#define PAYLOADPROFILER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <functional>
+
+#include "latencystats.h"
+
+// Read-only memory mapping of a file used as a call argument, so large
+// payloads never pass through an input widget or get read into a copy.
+class MappedPayload
+{
+public:
+    MappedPayload() = default;
+    ~MappedPayload();
+    MappedPayload(const MappedPayload&) = delete;
+    MappedPayload& operator=(const MappedPayload&) = delete;
+
+    bool open(const QString& path, QString* error = nullptr);
+
+    QString path() const { return m_file.fileName(); }
+    qint64 size() const { return m_size; }
+
+    // Wraps the mapping without copying; valid only while this object lives.
+    QByteArray bytes() const;
+
+private:
+    QFile m_file;
+    uchar* m_data = nullptr;
+    qint64 m_size = 0;
+};
+
+struct PayloadSweepPoint
+{
+    qint64 payloadBytes = 0;
+    qint64 argBytes = 0;
+    qint64 resultBytes = 0;
+    LatencySummary latency;
+    int failures = 0;
+
+    // Serialized arguments plus result moved per second at the median latency.
+    double throughputMBs() const;
+};
+
+class PayloadProfiler
+{
+public:
+    using RemoteInvoker = std::function<QVariant(const QString& methodName, const QVariantList& args, bool* ok)>;
+    using ProgressCallback = std::function<bool(qint64 payloadBytes, int index, int total)>;
+
+    // Size of the value as QDataStream would put it on the wire.
+    static qint64 serializedSize(const QVariant& value);
+    static qint64 serializedSize(const QVariantList& values);
+
+    // 1 KB, 4 KB, ... 64 MB.
+    static QVector<qint64> defaultSweepSizes();
+
+    // A payload of the given serialized size for a QString or QByteArray parameter.
+    static QVariant makePayload(qint64 bytes, bool asBytes);
+
+    // Replaces args[paramIndex] with payloads of increasing size and times
+    // repetitions calls at each size. The progress callback runs before each
+    // size and can return false to stop early.
+    static QVector<PayloadSweepPoint> runSweep(const QString& methodName, QVariantList args, int paramIndex,
+                                               bool asBytes, bool expectsResult, const QVector<qint64>& sizes, int repetitions,
+                                               const RemoteInvoker& remoteInvoker,
+                                               const ProgressCallback& progress = ProgressCallback());
+};
+
+#endif // PAYLOADPROFILER_H
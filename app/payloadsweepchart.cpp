@@ -0,0 +1,114 @@
+#include "payloadsweepchart.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <cmath>
+
+PayloadSweepChart::PayloadSweepChart(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumSize(480, 240);
+}
+
+void PayloadSweepChart::setPoints(const QVector<PayloadSweepPoint>& points)
+{
+    m_points = points;
+    update();
+}
+
+QSize PayloadSweepChart::sizeHint() const
+{
+    return QSize(640, 300);
+}
+
+QString PayloadSweepChart::formatBytes(qint64 bytes)
+{
+    if (bytes >= 1024LL * 1024 * 1024) {
+        return QString("%1 GB").arg(bytes / (1024.0 * 1024 * 1024), 0, 'g', 3);
+    }
+    if (bytes >= 1024 * 1024) {
+        return QString("%1 MB").arg(bytes / (1024.0 * 1024), 0, 'g', 3);
+    }
+    if (bytes >= 1024) {
+        return QString("%1 KB").arg(bytes / 1024.0, 0, 'g', 3);
+    }
+    return QString("%1 B").arg(bytes);
+}
+
+void PayloadSweepChart::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), QColor("#252525"));
+
+    const QRectF plot = QRectF(rect()).adjusted(64, 16, -64, -32);
+    painter.setPen(QColor("#3d3d3d"));
+    painter.drawRect(plot);
+
+    if (m_points.isEmpty()) {
+        painter.setPen(QColor("#888"));
+        painter.drawText(rect(), Qt::AlignCenter, "No sweep results yet");
+        return;
+    }
+
+    double minLog = std::log2(static_cast<double>(m_points.first().payloadBytes));
+    double maxLog = std::log2(static_cast<double>(m_points.last().payloadBytes));
+    if (maxLog <= minLog) {
+        maxLog = minLog + 1.0;
+    }
+    double maxThroughput = 0.0;
+    double maxLatency = 0.0;
+    for (const PayloadSweepPoint& point : m_points) {
+        maxThroughput = qMax(maxThroughput, point.throughputMBs());
+        maxLatency = qMax(maxLatency, point.latency.p50Ms);
+    }
+    if (maxThroughput <= 0.0) {
+        maxThroughput = 1.0;
+    }
+    if (maxLatency <= 0.0) {
+        maxLatency = 1.0;
+    }
+
+    auto xAt = [&](qint64 bytes) {
+        return plot.left() + (std::log2(static_cast<double>(bytes)) - minLog) / (maxLog - minLog) * plot.width();
+    };
+
+    QPainterPath throughputPath;
+    QPainterPath latencyPath;
+    for (int i = 0; i < m_points.size(); ++i) {
+        const PayloadSweepPoint& point = m_points.at(i);
+        const qreal x = xAt(point.payloadBytes);
+        const QPointF throughput(x, plot.bottom() - point.throughputMBs() / maxThroughput * plot.height());
+        const QPointF latency(x, plot.bottom() - point.latency.p50Ms / maxLatency * plot.height());
+        if (i == 0) {
+            throughputPath.moveTo(throughput);
+            latencyPath.moveTo(latency);
+        } else {
+            throughputPath.lineTo(throughput);
+            latencyPath.lineTo(latency);
+        }
+        painter.setPen(QColor("#3d3d3d"));
+        painter.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+        painter.setPen(QColor("#888"));
+        painter.drawText(QRectF(x - 40, plot.bottom() + 4, 80, 20), Qt::AlignHCenter | Qt::AlignTop,
+                         formatBytes(point.payloadBytes));
+        if (point.failures > 0) {
+            painter.setPen(QPen(QColor("#ff6b6b"), 2));
+            painter.drawEllipse(QPointF(x, plot.bottom() - 4), 3, 3);
+        }
+    }
+
+    painter.setPen(QPen(QColor("#5a9"), 2));
+    painter.drawPath(throughputPath);
+    painter.setPen(QPen(QColor("#6bb"), 2, Qt::DashLine));
+    painter.drawPath(latencyPath);
+
+    painter.setPen(QColor("#5a9"));
+    painter.drawText(QRectF(0, plot.top(), plot.left() - 6, 20), Qt::AlignRight | Qt::AlignTop,
+                     QString("%1 MB/s").arg(maxThroughput, 0, 'g', 4));
+    painter.drawText(QRectF(0, plot.bottom() - 20, plot.left() - 6, 20), Qt::AlignRight | Qt::AlignBottom, "0");
+    painter.setPen(QColor("#6bb"));
+    painter.drawText(QRectF(plot.right() + 6, plot.top(), 64, 20), Qt::AlignLeft | Qt::AlignTop,
+                     QString("%1 ms").arg(maxLatency, 0, 'g', 4));
+    painter.drawText(QRectF(plot.right() + 6, plot.bottom() - 20, 64, 20), Qt::AlignLeft | Qt::AlignBottom, "0");
+}
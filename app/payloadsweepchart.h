@@ -0,0 +1,31 @@
+#ifndef PAYLOADSWEEPCHART_H
+#define PAYLOADSWEEPCHART_H
+
+#include <QWidget>
+#include <QVector>
+
+#include "payloadprofiler.h"
+
+// Throughput (left axis) and median latency (right axis) against payload
+// size on a log2 x axis.
+class PayloadSweepChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PayloadSweepChart(QWidget* parent = nullptr);
+
+    void setPoints(const QVector<PayloadSweepPoint>& points);
+
+    QSize sizeHint() const override;
+
+    static QString formatBytes(qint64 bytes);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QVector<PayloadSweepPoint> m_points;
+};
+
+#endif // PAYLOADSWEEPCHART_H
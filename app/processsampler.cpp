@@ -0,0 +1,275 @@
+#include "processsampler.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSharedPointer>
+#include <QThread>
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace {
+
+QByteArray readProcFile(int pid, const char* name)
+{
+    QFile file(QString("/proc/%1/%2").arg(pid).arg(QLatin1String(name)));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+// Value of a "Key:   value" line in /proc/<pid>/status or io.
+quint64 fieldValue(const QByteArray& text, const QByteArray& key)
+{
+    int pos = text.startsWith(key) ? 0 : text.indexOf("\n" + key);
+    if (pos < 0) {
+        return 0;
+    }
+    if (text.at(pos) == '\n') {
+        ++pos;
+    }
+    int end = text.indexOf('\n', pos);
+    QByteArray value = text.mid(pos + key.size(), end < 0 ? -1 : end - pos - key.size()).trimmed();
+    int space = value.indexOf(' ');
+    if (space > 0) {
+        value.truncate(space);
+    }
+    return value.toULongLong();
+}
+
+// Fields of /proc/<pid>/stat after the command name, which is in
+// parentheses and may itself contain spaces. Index 0 is field 3 (state).
+QList<QByteArray> statFields(const QByteArray& stat)
+{
+    int close = stat.lastIndexOf(')');
+    if (close < 0) {
+        return QList<QByteArray>();
+    }
+    return stat.mid(close + 2).trimmed().split(' ');
+}
+
+double ticksPerSecond()
+{
+#ifdef Q_OS_LINUX
+    static const double ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+    return ticks > 0 ? ticks : 100.0;
+#else
+    return 100.0;
+#endif
+}
+
+}
+
+bool ProcessSampler::isSupported()
+{
+    return QFileInfo::exists("/proc/self/stat");
+}
+
+int ProcessSampler::cpuCount()
+{
+    return qMax(1, QThread::idealThreadCount());
+}
+
+bool ProcessSampler::readCounters(int pid, ProcessCounters* counters)
+{
+    const QList<QByteArray> stat = statFields(readProcFile(pid, "stat"));
+    if (stat.size() < 18) {
+        return false;
+    }
+
+    ProcessCounters c;
+    c.pid = pid;
+    c.parentPid = stat.at(1).toInt();
+    c.cpuTicks = stat.at(11).toULongLong() + stat.at(12).toULongLong();
+    c.threads = stat.at(17).toInt();
+
+    const QByteArray status = readProcFile(pid, "status");
+    c.rssBytes = static_cast<qint64>(fieldValue(status, "VmRSS:")) * 1024;
+    c.voluntarySwitches = fieldValue(status, "voluntary_ctxt_switches:");
+    c.involuntarySwitches = fieldValue(status, "nonvoluntary_ctxt_switches:");
+
+    // Readable for our own children; for other users' processes it is not,
+    // and the I/O columns stay at zero.
+    const QByteArray io = readProcFile(pid, "io");
+    c.readBytes = fieldValue(io, "rchar:");
+    c.writeBytes = fieldValue(io, "wchar:");
+    c.diskReadBytes = fieldValue(io, "read_bytes:");
+    c.diskWriteBytes = fieldValue(io, "write_bytes:");
+
+    c.fdCount = QDir(QString("/proc/%1/fd").arg(pid)).entryList(QDir::AllEntries | QDir::System | QDir::NoDotAndDotDot).size();
+
+    *counters = c;
+    return true;
+}
+
+void ProcessSampler::readThreadCounters(int pid, ProcessCounters* counters)
+{
+    counters->threadCounters.clear();
+    const QStringList tasks = QDir(QString("/proc/%1/task").arg(pid)).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& task : tasks) {
+        // Index 11/12 are utime/stime (fields 14/15), 36 is processor (39).
+        const QList<QByteArray> stat = statFields(readProcFile(pid, QString("task/%1/stat").arg(task).toUtf8().constData()));
+        if (stat.size() < 37) {
+            continue;
+        }
+        ThreadCounters thread;
+        thread.tid = task.toInt();
+        thread.cpuTicks = stat.at(11).toULongLong() + stat.at(12).toULongLong();
+        thread.processor = stat.at(36).toInt();
+        counters->threadCounters.append(thread);
+    }
+}
+
+QList<int> ProcessSampler::findHostPids(const QString& moduleName)
+{
+    QHash<int, int> parents;
+    QHash<int, QList<QByteArray>> hosts;
+
+    const QStringList entries = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& entry : entries) {
+        bool isPid = false;
+        int pid = entry.toInt(&isPid);
+        if (!isPid) {
+            continue;
+        }
+        const QList<QByteArray> stat = statFields(readProcFile(pid, "stat"));
+        if (stat.size() < 2) {
+            continue;
+        }
+        parents.insert(pid, stat.at(1).toInt());
+
+        const QList<QByteArray> argv = readProcFile(pid, "cmdline").split('\0');
+        if (!argv.isEmpty() && QFileInfo(QString::fromLocal8Bit(argv.first())).fileName().contains("logos_host")) {
+            hosts.insert(pid, argv);
+        }
+    }
+
+    const int self = static_cast<int>(QCoreApplication::applicationPid());
+    auto startedByUs = [&](int pid) {
+        for (int depth = 0; depth < 32 && pid > 1; ++depth) {
+            pid = parents.value(pid, 0);
+            if (pid == self) {
+                return true;
+            }
+        }
+        return false;
+    };
+    auto mentionsModule = [&](const QList<QByteArray>& argv) {
+        for (const QByteArray& arg : argv) {
+            if (!moduleName.isEmpty() && QString::fromLocal8Bit(arg).contains(moduleName)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    QList<int> ours;
+    QList<int> oursForModule;
+    QList<int> anyForModule;
+    for (auto it = hosts.constBegin(); it != hosts.constEnd(); ++it) {
+        const bool forModule = mentionsModule(it.value());
+        if (startedByUs(it.key())) {
+            ours << it.key();
+            if (forModule) {
+                oursForModule << it.key();
+            }
+        } else if (forModule) {
+            anyForModule << it.key();
+        }
+    }
+
+    QList<int> result = !oursForModule.isEmpty() ? oursForModule : (!ours.isEmpty() ? ours : anyForModule);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+void ProcessSampler::findHostPidsAsync(const QString& moduleName, QObject* context,
+                                       std::function<void(const QList<int>& pids)> done)
+{
+    QSharedPointer<QList<int>> pids(new QList<int>());
+    QThread* thread = QThread::create([moduleName, pids]() {
+        *pids = findHostPids(moduleName);
+    });
+    QObject::connect(thread, &QThread::finished, context, [pids, done]() {
+        done(*pids);
+    });
+    QObject::connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+ProcessSample ProcessSampler::aggregate(const QList<ProcessCounters>& current, const QList<ProcessCounters>& previous,
+                                        double timestampMs, double previousTimestampMs)
+{
+    ProcessSample sample;
+    sample.timestampMs = timestampMs;
+    sample.processCount = current.size();
+
+    const double seconds = (timestampMs - previousTimestampMs) / 1000.0;
+    quint64 cpuTicks = 0;
+    QVector<quint64> coreTicks(cpuCount(), 0);
+    quint64 voluntary = 0;
+    quint64 involuntary = 0;
+    quint64 readBytes = 0;
+    quint64 writeBytes = 0;
+    quint64 diskReadBytes = 0;
+    quint64 diskWriteBytes = 0;
+    auto delta = [](quint64 now, quint64 before) { return now >= before ? now - before : 0; };
+
+    for (const ProcessCounters& c : current) {
+        sample.rssBytes += c.rssBytes;
+        sample.threads += c.threads;
+        sample.fdCount += c.fdCount;
+
+        // A process without a previous reading (just found, or its pid was
+        // reused) contributes no rates this time.
+        for (const ProcessCounters& p : previous) {
+            if (p.pid != c.pid) {
+                continue;
+            }
+            cpuTicks += delta(c.cpuTicks, p.cpuTicks);
+            voluntary += delta(c.voluntarySwitches, p.voluntarySwitches);
+            involuntary += delta(c.involuntarySwitches, p.involuntarySwitches);
+            readBytes += delta(c.readBytes, p.readBytes);
+            writeBytes += delta(c.writeBytes, p.writeBytes);
+            diskReadBytes += delta(c.diskReadBytes, p.diskReadBytes);
+            diskWriteBytes += delta(c.diskWriteBytes, p.diskWriteBytes);
+
+            QHash<int, quint64> previousThreadTicks;
+            for (const ThreadCounters& thread : p.threadCounters) {
+                previousThreadTicks.insert(thread.tid, thread.cpuTicks);
+            }
+            for (const ThreadCounters& thread : c.threadCounters) {
+                if (thread.processor < 0) {
+                    continue;
+                }
+                if (thread.processor >= coreTicks.size()) {
+                    coreTicks.resize(thread.processor + 1);
+                }
+                // A thread started since the last sample ran only in between.
+                coreTicks[thread.processor] += delta(thread.cpuTicks, previousThreadTicks.value(thread.tid, 0));
+            }
+            break;
+        }
+    }
+
+    if (seconds > 0.0) {
+        sample.cpuPercent = cpuTicks / ticksPerSecond() / seconds * 100.0;
+        sample.cpuPercentByCore.resize(coreTicks.size());
+        for (int core = 0; core < coreTicks.size(); ++core) {
+            sample.cpuPercentByCore[core] = coreTicks.at(core) / ticksPerSecond() / seconds * 100.0;
+        }
+        sample.contextSwitchesPerSecond = (voluntary + involuntary) / seconds;
+        sample.involuntarySwitchesPerSecond = involuntary / seconds;
+        sample.readBytesPerSecond = readBytes / seconds;
+        sample.writeBytesPerSecond = writeBytes / seconds;
+        sample.diskReadBytesPerSecond = diskReadBytes / seconds;
+        sample.diskWriteBytesPerSecond = diskWriteBytes / seconds;
+    }
+    return sample;
+}
@@ -0,0 +1,91 @@
+#ifndef PROCESSSAMPLER_H
+#define PROCESSSAMPLER_H
+
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+class QObject;
+
+// CPU time of one thread and the core it last ran on, from
+// /proc/<pid>/task/<tid>/stat.
+struct ThreadCounters
+{
+    int tid = 0;
+    quint64 cpuTicks = 0;
+    int processor = 0;
+};
+
+// Cumulative counters for one process as read from /proc.
+struct ProcessCounters
+{
+    int pid = 0;
+    int parentPid = 0;
+    quint64 cpuTicks = 0;
+    qint64 rssBytes = 0;
+    int threads = 0;
+    quint64 voluntarySwitches = 0;
+    quint64 involuntarySwitches = 0;
+    // All read/write syscalls (sockets included) and what reached storage.
+    quint64 readBytes = 0;
+    quint64 writeBytes = 0;
+    quint64 diskReadBytes = 0;
+    quint64 diskWriteBytes = 0;
+    int fdCount = 0;
+    // Only filled in by readThreadCounters().
+    QList<ThreadCounters> threadCounters;
+};
+
+// One point of the resource timeline. Rates are per second over the time
+// since the previous sample; CPU is in percent of one core.
+struct ProcessSample
+{
+    double timestampMs = 0.0;
+    int processCount = 0;
+    double cpuPercent = 0.0;
+    // Approximate: each thread's CPU time since the previous sample is put
+    // on the core it was last seen on, so a thread that moved between cores
+    // counts all of it on the last one.
+    QVector<double> cpuPercentByCore;
+    qint64 rssBytes = 0;
+    int threads = 0;
+    int fdCount = 0;
+    double contextSwitchesPerSecond = 0.0;
+    double involuntarySwitchesPerSecond = 0.0;
+    double readBytesPerSecond = 0.0;
+    double writeBytesPerSecond = 0.0;
+    double diskReadBytesPerSecond = 0.0;
+    double diskWriteBytesPerSecond = 0.0;
+};
+
+// Reads process statistics from /proc/<pid>/stat, status, io and fd. Only
+// Linux has these; elsewhere every read fails and nothing is found.
+class ProcessSampler
+{
+public:
+    static bool isSupported();
+    static int cpuCount();
+
+    static bool readCounters(int pid, ProcessCounters* counters);
+    // Adds per-thread CPU time for a per-core breakdown. One file per
+    // thread, so only the resource monitor asks for it.
+    static void readThreadCounters(int pid, ProcessCounters* counters);
+
+    // logos_host processes serving moduleName. Hosts started by this
+    // process are preferred; if none of them mentions the module on its
+    // command line, all hosts started by this process are returned.
+    static QList<int> findHostPids(const QString& moduleName);
+    // Same scan on a short-lived thread, since walking all of /proc can take
+    // a while. done runs on context's thread, and not at all once context is
+    // gone.
+    static void findHostPidsAsync(const QString& moduleName, QObject* context,
+                                  std::function<void(const QList<int>& pids)> done);
+
+    // Sums the counters of several processes into one sample, with rates
+    // taken against previous (matched by pid).
+    static ProcessSample aggregate(const QList<ProcessCounters>& current, const QList<ProcessCounters>& previous,
+                                   double timestampMs, double previousTimestampMs);
+};
+
+#endif // PROCESSSAMPLER_H
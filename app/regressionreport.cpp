@@ -0,0 +1,466 @@
+#include "regressionreport.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QProcess>
+#include <QSet>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+QVector<double> samplesOf(const QJsonObject& call)
+{
+    QVector<double> samples;
+    const QJsonArray array = call.value("samplesMs").toArray();
+    samples.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        samples.append(value.toDouble());
+    }
+    return samples;
+}
+
+QString formatMs(double ms)
+{
+    return QString::number(ms, 'f', ms < 10.0 ? 3 : 1);
+}
+
+QJsonObject summaryToJson(const LatencySummary& summary)
+{
+    QJsonObject obj;
+    obj["count"] = summary.count;
+    obj["minMs"] = summary.minMs;
+    obj["maxMs"] = summary.maxMs;
+    obj["meanMs"] = summary.meanMs;
+    obj["stddevMs"] = summary.stddevMs;
+    obj["p50Ms"] = summary.p50Ms;
+    obj["p90Ms"] = summary.p90Ms;
+    obj["p99Ms"] = summary.p99Ms;
+    return obj;
+}
+
+}
+
+double MethodRegression::changePercent() const
+{
+    if (baseline.p50Ms <= 0.0) {
+        return 0.0;
+    }
+    return (candidate.p50Ms - baseline.p50Ms) / baseline.p50Ms * 100.0;
+}
+
+double MethodRegression::baselineThroughput() const
+{
+    return baseline.meanMs > 0.0 ? 1000.0 / baseline.meanMs : 0.0;
+}
+
+double MethodRegression::candidateThroughput() const
+{
+    return candidate.meanMs > 0.0 ? 1000.0 / candidate.meanMs : 0.0;
+}
+
+bool RegressionReport::hasRegression() const
+{
+    for (const MethodRegression& method : methods) {
+        if (method.regressed) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int RegressionReport::exitCode() const
+{
+    if (!error.isEmpty() || !schemaMatches()) {
+        return 2;
+    }
+    for (const MethodRegression& method : methods) {
+        if (!method.error.isEmpty()) {
+            return 2;
+        }
+    }
+    return hasRegression() ? 1 : 0;
+}
+
+double RegressionReport::mannWhitneyPValue(const QVector<double>& a, const QVector<double>& b)
+{
+    const int n1 = a.size();
+    const int n2 = b.size();
+    if (n1 == 0 || n2 == 0) {
+        return 1.0;
+    }
+
+    // Rank the pooled samples, giving ties their average rank.
+    QVector<QPair<double, int>> pooled;
+    pooled.reserve(n1 + n2);
+    for (double value : a) {
+        pooled.append(qMakePair(value, 0));
+    }
+    for (double value : b) {
+        pooled.append(qMakePair(value, 1));
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    const int n = pooled.size();
+    double rankSumA = 0.0;
+    double tieTerm = 0.0;
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j + 1 < n && pooled.at(j + 1).first == pooled.at(i).first) {
+            ++j;
+        }
+        const double rank = (i + j) / 2.0 + 1.0;
+        for (int k = i; k <= j; ++k) {
+            if (pooled.at(k).second == 0) {
+                rankSumA += rank;
+            }
+        }
+        const double tied = j - i + 1;
+        tieTerm += tied * tied * tied - tied;
+        i = j + 1;
+    }
+
+    // Normal approximation with tie correction and continuity correction;
+    // fine for the tens-to-thousands of samples a benchmark produces.
+    const double u = rankSumA - n1 * (n1 + 1) / 2.0;
+    const double mean = n1 * static_cast<double>(n2) / 2.0;
+    const double variance = n1 * static_cast<double>(n2) / 12.0
+        * ((n + 1) - tieTerm / (static_cast<double>(n) * (n - 1)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    const double z = qMax(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+QString RegressionReport::toText() const
+{
+    QString text;
+    auto version = [](const QString& v) { return v.isEmpty() ? QString() : QString(" (v%1)").arg(v); };
+    text += QString("Baseline:  %1%2\n").arg(baselinePath, version(baselineVersion));
+    text += QString("Candidate: %1%2\n").arg(candidatePath, version(candidateVersion));
+    text += QString("Regression: median latency up more than %1% at p < %2\n")
+        .arg(thresholdPercent, 0, 'f', 1).arg(alpha);
+
+    if (!error.isEmpty()) {
+        text += QString("\nError: %1\n").arg(error);
+        return text;
+    }
+
+    if (schemaMissing.isEmpty() && schemaAdded.isEmpty()) {
+        text += "Schema: identical\n";
+    } else {
+        for (const QString& signature : schemaMissing) {
+            text += QString("Schema: missing in candidate: %1\n").arg(signature);
+        }
+        for (const QString& signature : schemaAdded) {
+            text += QString("Schema: added in candidate: %1\n").arg(signature);
+        }
+    }
+
+    text += "\n";
+    text += QString("%1 %2 %3 %4 %5 %6 %7  %8\n")
+        .arg(QString("Method"), -32)
+        .arg(QString("base p50"), 10)
+        .arg(QString("cand p50"), 10)
+        .arg(QString("change"), 8)
+        .arg(QString("p-value"), 9)
+        .arg(QString("base/s"), 9)
+        .arg(QString("cand/s"), 9)
+        .arg("verdict");
+    int regressions = 0;
+    int improvements = 0;
+    for (const MethodRegression& method : methods) {
+        if (!method.error.isEmpty()) {
+            text += QString("%1 error: %2\n").arg(method.method, -32).arg(method.error);
+            continue;
+        }
+        QString verdict = "same";
+        if (method.regressed) {
+            verdict = "REGRESSED";
+            ++regressions;
+        } else if (method.improved) {
+            verdict = "improved";
+            ++improvements;
+        }
+        if (method.candidateFailures > method.baselineFailures) {
+            verdict += QString(" (%1 vs %2 failures)").arg(method.candidateFailures).arg(method.baselineFailures);
+        }
+        text += QString("%1 %2 %3 %4 %5 %6 %7  %8\n")
+            .arg(method.method, -32)
+            .arg(formatMs(method.baseline.p50Ms), 10)
+            .arg(formatMs(method.candidate.p50Ms), 10)
+            .arg(QString("%1%2%").arg(method.changePercent() >= 0 ? "+" : "").arg(method.changePercent(), 0, 'f', 1), 8)
+            .arg(QString::number(method.pValue, 'g', 2), 9)
+            .arg(QString::number(method.baselineThroughput(), 'f', 1), 9)
+            .arg(QString::number(method.candidateThroughput(), 'f', 1), 9)
+            .arg(verdict);
+    }
+    text += QString("\n%1 methods, %2 regressed, %3 improved\n").arg(methods.size()).arg(regressions).arg(improvements);
+    return text;
+}
+
+QJsonObject RegressionReport::toJson() const
+{
+    QJsonObject obj;
+    obj["baseline"] = baselinePath;
+    obj["candidate"] = candidatePath;
+    obj["baselineVersion"] = baselineVersion;
+    obj["candidateVersion"] = candidateVersion;
+    obj["thresholdPercent"] = thresholdPercent;
+    obj["alpha"] = alpha;
+    obj["schemaMissing"] = QJsonArray::fromStringList(schemaMissing);
+    obj["schemaAdded"] = QJsonArray::fromStringList(schemaAdded);
+    if (!error.isEmpty()) {
+        obj["error"] = error;
+    }
+
+    QJsonArray methodArray;
+    for (const MethodRegression& method : methods) {
+        QJsonObject m;
+        m["method"] = method.method;
+        if (!method.error.isEmpty()) {
+            m["error"] = method.error;
+        } else {
+            m["baseline"] = summaryToJson(method.baseline);
+            m["candidate"] = summaryToJson(method.candidate);
+            m["baselineFailures"] = method.baselineFailures;
+            m["candidateFailures"] = method.candidateFailures;
+            m["changePercent"] = method.changePercent();
+            m["pValue"] = method.pValue;
+            m["baselineCallsPerSecond"] = method.baselineThroughput();
+            m["candidateCallsPerSecond"] = method.candidateThroughput();
+            m["regressed"] = method.regressed;
+            m["improved"] = method.improved;
+        }
+        methodArray.append(m);
+    }
+    obj["methods"] = methodArray;
+    obj["exitCode"] = exitCode();
+    return obj;
+}
+
+RegressionRunner::RegressionRunner(QObject* parent)
+    : QObject(parent)
+    , m_runIndex(0)
+    , m_process(nullptr)
+{
+}
+
+RegressionRunner::~RegressionRunner()
+{
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->kill();
+        m_process->waitForFinished(3000);
+        QFile::remove(m_outputPath);
+    }
+}
+
+void RegressionRunner::start(const Options& options)
+{
+    if (m_process) {
+        return;
+    }
+
+    m_options = options;
+    m_runIsBaseline.clear();
+    m_baselineRuns.clear();
+    m_candidateRuns.clear();
+    m_error.clear();
+    m_runIndex = 0;
+
+    for (int round = 0; round < qMax(1, options.rounds); ++round) {
+        const bool baselineFirst = round % 2 == 0;
+        m_runIsBaseline << baselineFirst << !baselineFirst;
+    }
+    startNextRun();
+}
+
+void RegressionRunner::startNextRun()
+{
+    if (m_runIndex >= m_runIsBaseline.size()) {
+        finish();
+        return;
+    }
+
+    const bool isBaseline = m_runIsBaseline.at(m_runIndex);
+    const QString path = isBaseline ? m_options.baselinePath : m_options.candidatePath;
+    m_outputPath = QDir(QDir::tempPath()).filePath(QString("logos-module-viewer-bench-%1-%2.json")
+        .arg(QCoreApplication::applicationPid())
+        .arg(m_runIndex));
+    QFile::remove(m_outputPath);
+
+    QStringList args;
+    args << "--bench" << path << "--bench-output" << m_outputPath;
+    if (!m_options.callsPath.isEmpty()) {
+        args << "--calls" << m_options.callsPath;
+    }
+
+    emit progress(QString("Run %1/%2: %3 %4")
+        .arg(m_runIndex + 1)
+        .arg(m_runIsBaseline.size())
+        .arg(isBaseline ? "baseline" : "candidate")
+        .arg(path));
+
+    m_process = new QProcess(this);
+    m_process->setProcessChannelMode(QProcess::ForwardedChannels);
+    connect(m_process, &QProcess::finished, this, [this](int exitCode, QProcess::ExitStatus status) {
+        onRunFinished(status == QProcess::NormalExit ? exitCode : -1);
+    });
+    connect(m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            onRunFinished(-1);
+        }
+    });
+    m_process->start(QCoreApplication::applicationFilePath(), args);
+}
+
+void RegressionRunner::onRunFinished(int exitCode)
+{
+    QProcess* process = m_process;
+    m_process = nullptr;
+    process->disconnect(this);
+    process->deleteLater();
+
+    const bool isBaseline = m_runIsBaseline.at(m_runIndex);
+    const QString path = isBaseline ? m_options.baselinePath : m_options.candidatePath;
+    QJsonObject result;
+    QFile file(m_outputPath);
+    if (file.open(QIODevice::ReadOnly)) {
+        result = QJsonDocument::fromJson(file.readAll()).object();
+        file.close();
+    }
+    QFile::remove(m_outputPath);
+
+    if (result.isEmpty()) {
+        m_error = QString("Benchmark of %1 produced no result (exit code %2)").arg(path).arg(exitCode);
+        finish();
+        return;
+    }
+    if (result.contains("error")) {
+        m_error = QString("Benchmark of %1 failed: %2").arg(path, result.value("error").toString());
+        finish();
+        return;
+    }
+
+    if (isBaseline) {
+        m_baselineRuns.append(result);
+    } else {
+        m_candidateRuns.append(result);
+    }
+    ++m_runIndex;
+    startNextRun();
+}
+
+void RegressionRunner::finish()
+{
+    RegressionReport report;
+    report.baselinePath = m_options.baselinePath;
+    report.candidatePath = m_options.candidatePath;
+    report.thresholdPercent = m_options.thresholdPercent;
+    report.alpha = m_options.alpha;
+    report.error = m_error;
+
+    if (report.error.isEmpty() && (m_baselineRuns.isEmpty() || m_candidateRuns.isEmpty())) {
+        report.error = "Nothing was benchmarked";
+    }
+    if (!report.error.isEmpty()) {
+        emit finished(report);
+        return;
+    }
+
+    const QJsonObject& baseline = m_baselineRuns.first();
+    const QJsonObject& candidate = m_candidateRuns.first();
+    report.baselineVersion = baseline.value("version").toString();
+    report.candidateVersion = candidate.value("version").toString();
+
+    QSet<QString> baselineSchema;
+    for (const QJsonValue& value : baseline.value("schema").toArray()) {
+        baselineSchema.insert(value.toString());
+    }
+    QSet<QString> candidateSchema;
+    for (const QJsonValue& value : candidate.value("schema").toArray()) {
+        candidateSchema.insert(value.toString());
+    }
+    report.schemaMissing = QStringList(baselineSchema.begin(), baselineSchema.end());
+    report.schemaMissing.removeIf([&](const QString& s) { return candidateSchema.contains(s); });
+    report.schemaMissing.sort();
+    report.schemaAdded = QStringList(candidateSchema.begin(), candidateSchema.end());
+    report.schemaAdded.removeIf([&](const QString& s) { return baselineSchema.contains(s); });
+    report.schemaAdded.sort();
+
+    // Without a call file each build picks its own read-only methods, so the
+    // lists can differ in content and order. Calls are matched by signature
+    // (and, for repeated signatures, by occurrence); a call only one build
+    // made is left out here, the schema diff above already reports it.
+    auto callsByKey = [](const QJsonObject& run, QStringList* order) {
+        QHash<QString, QJsonObject> byKey;
+        QHash<QString, int> seen;
+        for (const QJsonValue& value : run.value("calls").toArray()) {
+            const QJsonObject call = value.toObject();
+            const QString signature = call.value("signature").toString(call.value("method").toString());
+            const QString key = QString("%1#%2").arg(signature).arg(seen[signature]++);
+            byKey.insert(key, call);
+            if (order) {
+                order->append(key);
+            }
+        }
+        return byKey;
+    };
+    QStringList keys;
+    callsByKey(baseline, &keys);
+    QVector<QHash<QString, QJsonObject>> baselineCalls;
+    for (const QJsonObject& run : std::as_const(m_baselineRuns)) {
+        baselineCalls.append(callsByKey(run, nullptr));
+    }
+    QVector<QHash<QString, QJsonObject>> candidateCalls;
+    for (const QJsonObject& run : std::as_const(m_candidateRuns)) {
+        candidateCalls.append(callsByKey(run, nullptr));
+    }
+
+    for (const QString& key : std::as_const(keys)) {
+        if (!candidateCalls.first().contains(key)) {
+            continue;
+        }
+        MethodRegression method;
+        QVector<double> baselineSamples;
+        QVector<double> candidateSamples;
+        auto collect = [&](const QVector<QHash<QString, QJsonObject>>& runs, QVector<double>* samples, int* failures) {
+            for (const QHash<QString, QJsonObject>& calls : runs) {
+                auto it = calls.constFind(key);
+                if (it == calls.constEnd()) {
+                    continue;
+                }
+                const QJsonObject& call = it.value();
+                if (method.method.isEmpty()) {
+                    method.method = call.value("signature").toString(call.value("method").toString());
+                }
+                if (call.contains("error") && method.error.isEmpty()) {
+                    method.error = call.value("error").toString();
+                }
+                *samples += samplesOf(call);
+                *failures += call.value("failures").toInt();
+            }
+        };
+        collect(baselineCalls, &baselineSamples, &method.baselineFailures);
+        collect(candidateCalls, &candidateSamples, &method.candidateFailures);
+
+        if (method.error.isEmpty()) {
+            method.baseline = LatencySummary::fromSamples(baselineSamples);
+            method.candidate = LatencySummary::fromSamples(candidateSamples);
+            method.pValue = RegressionReport::mannWhitneyPValue(baselineSamples, candidateSamples);
+            const bool significant = method.pValue < report.alpha;
+            method.regressed = (significant && method.changePercent() > report.thresholdPercent)
+                || method.candidateFailures > method.baselineFailures;
+            method.improved = !method.regressed && significant && method.changePercent() < -report.thresholdPercent;
+        }
+        report.methods.append(method);
+    }
+
+    emit finished(report);
+}
@@ -0,0 +1,105 @@
+#ifndef REGRESSIONREPORT_H
+#define REGRESSIONREPORT_H
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "latencystats.h"
+
+class QProcess;
+
+struct MethodRegression
+{
+    QString method;
+    LatencySummary baseline;
+    LatencySummary candidate;
+    int baselineFailures = 0;
+    int candidateFailures = 0;
+    // Two-sided Mann-Whitney U p-value for "same latency distribution".
+    double pValue = 1.0;
+    bool regressed = false;
+    bool improved = false;
+    QString error;
+
+    // Median latency change, candidate against baseline.
+    double changePercent() const;
+    // Sequential calls per second, from mean latency.
+    double baselineThroughput() const;
+    double candidateThroughput() const;
+};
+
+struct RegressionReport
+{
+    QString baselinePath;
+    QString candidatePath;
+    QString baselineVersion;
+    QString candidateVersion;
+    double thresholdPercent = 10.0;
+    double alpha = 0.05;
+    // Methods the candidate no longer has, and methods it added.
+    QStringList schemaMissing;
+    QStringList schemaAdded;
+    QVector<MethodRegression> methods;
+    QString error;
+
+    bool schemaMatches() const { return schemaMissing.isEmpty(); }
+    bool hasRegression() const;
+    // 0 when nothing regressed, 1 on a regression, 2 when the comparison
+    // could not be made (a run failed or the schemas differ).
+    int exitCode() const;
+
+    QString toText() const;
+    QJsonObject toJson() const;
+
+    static double mannWhitneyPValue(const QVector<double>& a, const QVector<double>& b);
+};
+
+// Benchmarks two builds of a module, each in its own viewer process (and so
+// its own logos core and host), with the same calls, and compares them.
+// With rounds > 1 the runs alternate baseline/candidate in ABBA order to
+// spread out drift on the machine.
+class RegressionRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString baselinePath;
+        QString candidatePath;
+        // Call file; empty runs every read-only method without parameters.
+        QString callsPath;
+        double thresholdPercent = 10.0;
+        double alpha = 0.05;
+        int rounds = 1;
+    };
+
+    explicit RegressionRunner(QObject* parent = nullptr);
+    ~RegressionRunner();
+
+    void start(const Options& options);
+    bool isRunning() const { return m_process != nullptr; }
+
+signals:
+    void progress(const QString& message);
+    void finished(const RegressionReport& report);
+
+private:
+    void startNextRun();
+    void onRunFinished(int exitCode);
+    void finish();
+
+    Options m_options;
+    // Role of each run in order; the two paths may name the same file.
+    QVector<bool> m_runIsBaseline;
+    int m_runIndex;
+    QProcess* m_process;
+    QString m_outputPath;
+    QVector<QJsonObject> m_baselineRuns;
+    QVector<QJsonObject> m_candidateRuns;
+    QString m_error;
+};
+
+#endif // REGRESSIONREPORT_H
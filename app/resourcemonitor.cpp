@@ -0,0 +1,135 @@
+#include "resourcemonitor.h"
+#include "monotonicclock.h"
+
+#include <QTimer>
+
+namespace {
+// Hosts can be restarted by a reconnect; look for them again this often.
+const int kRediscoverMs = 2000;
+}
+
+ResourceMonitor::ResourceMonitor(QObject* parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_previousMs(0.0)
+    , m_ticksSinceDiscovery(0)
+    , m_discovering(false)
+    , m_pidsStale(true)
+    , m_samples(3600)
+    , m_calls(2000)
+    , m_events(20000)
+{
+    m_timer->setInterval(500);
+    connect(m_timer, &QTimer::timeout, this, &ResourceMonitor::sampleNow);
+}
+
+void ResourceMonitor::setModuleName(const QString& moduleName)
+{
+    if (moduleName == m_moduleName) {
+        return;
+    }
+    m_moduleName = moduleName;
+    m_samples.clear();
+    m_calls.clear();
+    m_events.clear();
+    m_previous.clear();
+    m_pids.clear();
+    m_ticksSinceDiscovery = 0;
+    m_pidsStale = true;
+    emit pidsChanged(m_pids);
+    emit sampled();
+}
+
+void ResourceMonitor::setInterval(int ms)
+{
+    m_timer->setInterval(qMax(50, ms));
+}
+
+int ResourceMonitor::interval() const
+{
+    return m_timer->interval();
+}
+
+void ResourceMonitor::start()
+{
+    if (!ProcessSampler::isSupported()) {
+        return;
+    }
+    m_timer->start();
+    sampleNow();
+}
+
+void ResourceMonitor::stop()
+{
+    m_timer->stop();
+}
+
+bool ResourceMonitor::isRunning() const
+{
+    return m_timer->isActive();
+}
+
+void ResourceMonitor::addCall(const CallMarker& call)
+{
+    m_calls.push(call);
+}
+
+void ResourceMonitor::addEvent(double timestampMs)
+{
+    m_events.push(timestampMs);
+}
+
+void ResourceMonitor::refreshPids()
+{
+    m_discovering = true;
+    m_pidsStale = false;
+    m_ticksSinceDiscovery = 0;
+    const QString moduleName = m_moduleName;
+    ProcessSampler::findHostPidsAsync(moduleName, this, [this, moduleName](const QList<int>& pids) {
+        m_discovering = false;
+        if (moduleName != m_moduleName) {
+            m_pidsStale = true;
+            return;
+        }
+        if (pids != m_pids) {
+            m_pids = pids;
+            emit pidsChanged(m_pids);
+        }
+    });
+}
+
+void ResourceMonitor::sampleNow()
+{
+    if (m_moduleName.isEmpty()) {
+        return;
+    }
+
+    ++m_ticksSinceDiscovery;
+    if (!m_discovering && (m_pidsStale || m_ticksSinceDiscovery * m_timer->interval() >= kRediscoverMs)) {
+        refreshPids();
+    }
+
+    const double nowMs = MonotonicClock::nowMs();
+    QList<ProcessCounters> current;
+    bool lostProcess = false;
+    for (int pid : std::as_const(m_pids)) {
+        ProcessCounters counters;
+        if (ProcessSampler::readCounters(pid, &counters)) {
+            ProcessSampler::readThreadCounters(pid, &counters);
+            current.append(counters);
+        } else {
+            lostProcess = true;
+        }
+    }
+    if (lostProcess) {
+        // Picked up again once the next scan finishes.
+        m_pidsStale = true;
+    }
+
+    if (!current.isEmpty()) {
+        m_samples.push(ProcessSampler::aggregate(current, m_previous, nowMs, m_previousMs));
+    }
+    m_previous = current;
+    m_previousMs = nowMs;
+    emit sampled();
+}
@@ -0,0 +1,74 @@
+#ifndef RESOURCEMONITOR_H
+#define RESOURCEMONITOR_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+
+#include "processsampler.h"
+#include "ringbuffer.h"
+
+class QTimer;
+
+// A remote call as seen from the viewer, on the MonotonicClock timeline.
+struct CallMarker
+{
+    double startMs = 0.0;
+    double endMs = 0.0;
+    QString method;
+    bool ok = true;
+};
+
+// Periodically samples the logos_host process(es) serving a module and
+// keeps a rolling history, together with the calls and events that
+// happened in the same period, so they can be drawn on one timeline.
+class ResourceMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ResourceMonitor(QObject* parent = nullptr);
+
+    void setModuleName(const QString& moduleName);
+    QString moduleName() const { return m_moduleName; }
+    void setInterval(int ms);
+    int interval() const;
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    const QList<int>& pids() const { return m_pids; }
+    const RingBuffer<ProcessSample>& samples() const { return m_samples; }
+    const RingBuffer<CallMarker>& calls() const { return m_calls; }
+    const RingBuffer<double>& events() const { return m_events; }
+
+    void addCall(const CallMarker& call);
+    void addEvent(double timestampMs);
+
+public slots:
+    void sampleNow();
+
+signals:
+    void sampled();
+    void pidsChanged(const QList<int>& pids);
+
+private:
+    void refreshPids();
+
+    QString m_moduleName;
+    QTimer* m_timer;
+    QList<int> m_pids;
+    QList<ProcessCounters> m_previous;
+    double m_previousMs;
+    int m_ticksSinceDiscovery;
+    // A /proc scan is running on its own thread; m_pidsStale asks for one
+    // on the next tick instead of waiting for the periodic rescan.
+    bool m_discovering;
+    bool m_pidsStale;
+    RingBuffer<ProcessSample> m_samples;
+    RingBuffer<CallMarker> m_calls;
+    RingBuffer<double> m_events;
+};
+
+#endif // RESOURCEMONITOR_H
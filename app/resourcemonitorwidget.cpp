@@ -0,0 +1,261 @@
+#include "resourcemonitorwidget.h"
+#include "monotonicclock.h"
+#include "payloadsweepchart.h"
+#include "resourcemonitor.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPainterPath>
+#include <QToolTip>
+#include <functional>
+
+namespace {
+
+const int kEventStripHeight = 10;
+const int kLabelHeight = 14;
+
+struct Band {
+    QString title;
+    QColor color;
+    std::function<double(const ProcessSample&)> value;
+    std::function<double(const ProcessSample&)> secondValue;
+    std::function<QString(double)> format;
+    // Drawn as one shaded row per core from cpuPercentByCore instead of a line.
+    bool perCore = false;
+};
+
+QVector<Band> bands()
+{
+    auto rate = [](double bytes) { return PayloadSweepChart::formatBytes(static_cast<qint64>(bytes)) + "/s"; };
+    return {
+        {"CPU (% of one core)", QColor("#5a9"),
+         [](const ProcessSample& s) { return s.cpuPercent; }, nullptr,
+         [](double v) { return QString("%1%").arg(v, 0, 'f', 1); }},
+        {"CPU by core (approx.), busiest", QColor("#5a9"),
+         [](const ProcessSample& s) {
+             double busiest = 0.0;
+             for (double percent : s.cpuPercentByCore) {
+                 busiest = qMax(busiest, percent);
+             }
+             return busiest;
+         }, nullptr,
+         [](double v) { return QString("%1%").arg(v, 0, 'f', 1); }, true},
+        {"RSS", QColor("#6bb"),
+         [](const ProcessSample& s) { return static_cast<double>(s.rssBytes); }, nullptr,
+         [](double v) { return PayloadSweepChart::formatBytes(static_cast<qint64>(v)); }},
+        {"Threads", QColor("#b0b0b0"),
+         [](const ProcessSample& s) { return static_cast<double>(s.threads); }, nullptr,
+         [](double v) { return QString::number(static_cast<int>(v)); }},
+        {"Context switches/s (involuntary dashed)", QColor("#e0b050"),
+         [](const ProcessSample& s) { return s.contextSwitchesPerSecond; },
+         [](const ProcessSample& s) { return s.involuntarySwitchesPerSecond; },
+         [](double v) { return QString::number(v, 'f', 0); }},
+        {"I/O read (write dashed)", QColor("#9a7fd1"),
+         [](const ProcessSample& s) { return s.readBytesPerSecond; },
+         [](const ProcessSample& s) { return s.writeBytesPerSecond; },
+         rate},
+    };
+}
+
+}
+
+ResourceMonitorWidget::ResourceMonitorWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_windowMs(60000)
+{
+    setMinimumHeight(300);
+    setMouseTracking(true);
+}
+
+void ResourceMonitorWidget::setMonitor(ResourceMonitor* monitor)
+{
+    if (m_monitor) {
+        disconnect(m_monitor, nullptr, this, nullptr);
+    }
+    m_monitor = monitor;
+    if (m_monitor) {
+        connect(m_monitor, &ResourceMonitor::sampled, this, qOverload<>(&QWidget::update));
+    }
+    update();
+}
+
+void ResourceMonitorWidget::setWindowMs(int windowMs)
+{
+    m_windowMs = qMax(1000, windowMs);
+    update();
+}
+
+QSize ResourceMonitorWidget::sizeHint() const
+{
+    return QSize(640, 320);
+}
+
+QRectF ResourceMonitorWidget::plotArea() const
+{
+    return QRectF(rect()).adjusted(6, 4, -6, -(kEventStripHeight + 6));
+}
+
+void ResourceMonitorWidget::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#252525"));
+
+    if (!m_monitor || m_monitor->samples().isEmpty()) {
+        painter.setPen(QColor("#888"));
+        painter.drawText(rect(), Qt::AlignCenter, m_monitor && !m_monitor->moduleName().isEmpty()
+            ? "Looking for the module's logos_host process..."
+            : "Load a module to monitor its host process");
+        return;
+    }
+
+    const QRectF area = plotArea();
+    const double nowMs = MonotonicClock::nowMs();
+    const double startMs = nowMs - m_windowMs;
+    auto xAt = [&](double ms) { return area.left() + (ms - startMs) / m_windowMs * area.width(); };
+
+    // Calls first so the lines draw over them.
+    const RingBuffer<CallMarker>& calls = m_monitor->calls();
+    for (int i = 0; i < calls.size(); ++i) {
+        const CallMarker& call = calls.at(i);
+        if (call.endMs < startMs) {
+            continue;
+        }
+        const qreal left = qMax(area.left(), xAt(call.startMs));
+        const qreal right = qMax(left + 1.0, xAt(call.endMs));
+        QColor color = call.ok ? QColor("#6bb") : QColor("#ff6b6b");
+        color.setAlpha(50);
+        painter.fillRect(QRectF(left, area.top(), right - left, area.height()), color);
+    }
+
+    const RingBuffer<ProcessSample>& samples = m_monitor->samples();
+    const QVector<Band> bandList = bands();
+    const qreal bandGap = 4;
+    const qreal bandHeight = (area.height() - bandGap * (bandList.size() - 1)) / bandList.size();
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    for (int b = 0; b < bandList.size(); ++b) {
+        const Band& band = bandList.at(b);
+        const QRectF bandRect(area.left(), area.top() + b * (bandHeight + bandGap), area.width(), bandHeight);
+        const QRectF plotRect = bandRect.adjusted(0, kLabelHeight, 0, -2);
+        painter.setPen(QColor("#3d3d3d"));
+        painter.drawRect(bandRect);
+
+        if (band.perCore) {
+            int cores = 0;
+            for (int i = 0; i < samples.size(); ++i) {
+                cores = qMax(cores, static_cast<int>(samples.at(i).cpuPercentByCore.size()));
+            }
+            const qreal rowHeight = cores > 0 ? plotRect.height() / cores : 0.0;
+            for (int i = 1; i < samples.size(); ++i) {
+                const ProcessSample& s = samples.at(i);
+                if (s.timestampMs < startMs) {
+                    continue;
+                }
+                const qreal left = qMax(area.left(), xAt(samples.at(i - 1).timestampMs));
+                const qreal width = qMax(1.0, xAt(s.timestampMs) - left);
+                for (int core = 0; core < s.cpuPercentByCore.size(); ++core) {
+                    const double busy = qBound(0.0, s.cpuPercentByCore.at(core) / 100.0, 1.0);
+                    if (busy <= 0.0) {
+                        continue;
+                    }
+                    QColor color = band.color;
+                    color.setAlphaF(busy);
+                    painter.fillRect(QRectF(left, plotRect.top() + core * rowHeight, width, qMax<qreal>(1.0, rowHeight)), color);
+                }
+            }
+            painter.setPen(QColor("#b0b0b0"));
+            painter.drawText(bandRect.adjusted(6, 1, -6, 0), Qt::AlignLeft | Qt::AlignTop,
+                QString("%1: %2   (%3 cores)").arg(band.title, band.format(band.value(samples.last()))).arg(cores));
+            continue;
+        }
+
+        double maxValue = 0.0;
+        for (int i = 0; i < samples.size(); ++i) {
+            const ProcessSample& s = samples.at(i);
+            if (s.timestampMs < startMs) {
+                continue;
+            }
+            maxValue = qMax(maxValue, band.value(s));
+            if (band.secondValue) {
+                maxValue = qMax(maxValue, band.secondValue(s));
+            }
+        }
+        if (maxValue <= 0.0) {
+            maxValue = 1.0;
+        }
+
+        auto drawSeries = [&](const std::function<double(const ProcessSample&)>& value, Qt::PenStyle style) {
+            QPainterPath path;
+            bool started = false;
+            for (int i = 0; i < samples.size(); ++i) {
+                const ProcessSample& s = samples.at(i);
+                if (s.timestampMs < startMs) {
+                    continue;
+                }
+                const QPointF point(xAt(s.timestampMs), plotRect.bottom() - value(s) / maxValue * plotRect.height());
+                if (started) {
+                    path.lineTo(point);
+                } else {
+                    path.moveTo(point);
+                    started = true;
+                }
+            }
+            painter.setPen(QPen(band.color, 1.5, style));
+            painter.drawPath(path);
+        };
+        drawSeries(band.value, Qt::SolidLine);
+        if (band.secondValue) {
+            drawSeries(band.secondValue, Qt::DashLine);
+        }
+
+        const ProcessSample& latest = samples.last();
+        QString label = QString("%1: %2").arg(band.title, band.format(band.value(latest)));
+        if (band.secondValue) {
+            label += QString(" / %1").arg(band.format(band.secondValue(latest)));
+        }
+        label += QString("   (max %1)").arg(band.format(maxValue));
+        painter.setPen(QColor("#b0b0b0"));
+        painter.drawText(bandRect.adjusted(6, 1, -6, 0), Qt::AlignLeft | Qt::AlignTop, label);
+    }
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    // One tick per pixel column that saw at least one event.
+    const QRectF strip(area.left(), area.bottom() + 4, area.width(), kEventStripHeight);
+    const RingBuffer<double>& events = m_monitor->events();
+    painter.setPen(QColor("#e0b050"));
+    int lastColumn = -1;
+    for (int i = 0; i < events.size(); ++i) {
+        const double ms = events.at(i);
+        if (ms < startMs) {
+            continue;
+        }
+        const int column = static_cast<int>(xAt(ms));
+        if (column != lastColumn) {
+            painter.drawLine(column, static_cast<int>(strip.top()), column, static_cast<int>(strip.bottom()));
+            lastColumn = column;
+        }
+    }
+}
+
+void ResourceMonitorWidget::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!m_monitor) {
+        return;
+    }
+
+    const QRectF area = plotArea();
+    const double nowMs = MonotonicClock::nowMs();
+    const double ms = nowMs - m_windowMs + (event->position().x() - area.left()) / area.width() * m_windowMs;
+
+    const RingBuffer<CallMarker>& calls = m_monitor->calls();
+    for (int i = calls.size() - 1; i >= 0; --i) {
+        const CallMarker& call = calls.at(i);
+        if (ms >= call.startMs - 50 && ms <= call.endMs + 50) {
+            QToolTip::showText(event->globalPosition().toPoint(),
+                QString("%1: %2 ms%3").arg(call.method).arg(call.endMs - call.startMs, 0, 'f', 2)
+                    .arg(call.ok ? QString() : QString(" (failed)")), this);
+            return;
+        }
+    }
+    QToolTip::hideText();
+}
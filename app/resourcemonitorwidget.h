@@ -0,0 +1,35 @@
+#ifndef RESOURCEMONITORWIDGET_H
+#define RESOURCEMONITORWIDGET_H
+
+#include <QWidget>
+#include <QPointer>
+
+class ResourceMonitor;
+
+// Stacked charts of a ResourceMonitor's history (CPU in total and by core,
+// RSS, threads, context switches, I/O) over the last minute, with calls
+// shaded across all bands and event arrivals ticked along the bottom.
+class ResourceMonitorWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ResourceMonitorWidget(QWidget* parent = nullptr);
+
+    void setMonitor(ResourceMonitor* monitor);
+    void setWindowMs(int windowMs);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+private:
+    QRectF plotArea() const;
+
+    QPointer<ResourceMonitor> m_monitor;
+    int m_windowMs;
+};
+
+#endif // RESOURCEMONITORWIDGET_H
@@ -0,0 +1,48 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <QVector>
+
+// Fixed-capacity buffer that overwrites its oldest entry once full.
+// Index 0 is always the oldest element still held.
+template <typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(int capacity = 0)
+        : m_data(capacity > 0 ? capacity : 1)
+        , m_head(0)
+        , m_size(0)
+    {
+    }
+
+    void push(const T& value)
+    {
+        m_data[(m_head + m_size) % m_data.size()] = value;
+        if (m_size < m_data.size()) {
+            ++m_size;
+        } else {
+            m_head = (m_head + 1) % m_data.size();
+        }
+    }
+
+    const T& at(int index) const { return m_data.at((m_head + index) % m_data.size()); }
+    const T& last() const { return at(m_size - 1); }
+
+    int size() const { return m_size; }
+    int capacity() const { return m_data.size(); }
+    bool isEmpty() const { return m_size == 0; }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+private:
+    QVector<T> m_data;
+    int m_head;
+    int m_size;
+};
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,378 @@
+#include "soaktest.h"
+#include "benchmarkrunner.h"
+#include "connectionpool.h"
+#include "latencystats.h"
+#include "modulesession.h"
+#include "payloadsweepchart.h"
+#include "processsampler.h"
+#include "logos_api_client.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QTimer>
+#include <iostream>
+
+namespace {
+
+void settle(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+// Flags a trend as a leak when it rises steadily (a good linear fit) and
+// the fitted growth over the run is larger than noise would explain.
+void judge(SoakTrend* trend, double minimumGrowth, int points)
+{
+    const double growth = trend->slopePerCycle * (points - 1);
+    trend->leak = points >= 5 && trend->slopePerCycle > 0.0 && trend->r2 >= 0.6 && growth >= minimumGrowth;
+}
+
+}
+
+SoakTrend SoakTrend::fit(const QString& metric, const QString& unit, const QVector<double>& values)
+{
+    SoakTrend trend;
+    trend.metric = metric;
+    trend.unit = unit;
+    const int n = values.size();
+    if (n == 0) {
+        return trend;
+    }
+    trend.first = values.first();
+    trend.last = values.last();
+    if (n < 2) {
+        return trend;
+    }
+
+    double meanX = (n - 1) / 2.0;
+    double meanY = 0.0;
+    for (double y : values) {
+        meanY += y;
+    }
+    meanY /= n;
+
+    double sxx = 0.0;
+    double sxy = 0.0;
+    double syy = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double dx = i - meanX;
+        const double dy = values.at(i) - meanY;
+        sxx += dx * dx;
+        sxy += dx * dy;
+        syy += dy * dy;
+    }
+    trend.slopePerCycle = sxy / sxx;
+    trend.r2 = syy > 0.0 ? (sxy * sxy) / (sxx * syy) : 0.0;
+    return trend;
+}
+
+bool SoakReport::hasLeak() const
+{
+    for (const SoakTrend& trend : trends) {
+        if (trend.leak) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SoakReport::exitCode() const
+{
+    if (!error.isEmpty() || cycles.isEmpty()) {
+        return 2;
+    }
+    return hasLeak() ? 1 : 0;
+}
+
+QString SoakReport::toText() const
+{
+    QString text;
+    text += QString("Soak test: %1\n").arg(modulePath);
+    text += QString("%1 cycles").arg(cycles.size());
+    if (!cycles.isEmpty()) {
+        text += QString(" in %1 s").arg(cycles.last().elapsedSeconds, 0, 'f', 0);
+    }
+    text += "\n";
+    if (!error.isEmpty()) {
+        text += QString("Error: %1\n").arg(error);
+    }
+    if (trends.isEmpty()) {
+        return text;
+    }
+
+    text += QString("Trends after %1 warm-up cycles:\n").arg(SoakTest::warmupCycles(cycles.size()));
+    for (const SoakTrend& trend : trends) {
+        auto value = [&](double v) {
+            return trend.unit == "bytes" ? PayloadSweepChart::formatBytes(static_cast<qint64>(v))
+                                         : QString("%1 %2").arg(v, 0, 'f', trend.unit == "ms" ? 3 : 0).arg(trend.unit);
+        };
+        const QString slope = trend.unit == "bytes"
+            ? PayloadSweepChart::formatBytes(static_cast<qint64>(trend.slopePerCycle))
+            : QString::number(trend.slopePerCycle, 'f', 4);
+        text += QString("  %1 %2 -> %3, %4 per cycle, R^2 %5%6\n")
+            .arg(trend.metric, -22)
+            .arg(value(trend.first))
+            .arg(value(trend.last))
+            .arg(slope)
+            .arg(trend.r2, 0, 'f', 2)
+            .arg(trend.leak ? "  LEAK?" : "");
+    }
+    text += hasLeak() ? "Result: growth that looks like a leak\n" : "Result: no leak detected\n";
+    return text;
+}
+
+QJsonObject SoakReport::toJson() const
+{
+    QJsonObject obj;
+    obj["module"] = modulePath;
+    if (!error.isEmpty()) {
+        obj["error"] = error;
+    }
+
+    QJsonArray cycleArray;
+    for (const SoakCycle& c : cycles) {
+        QJsonObject o;
+        o["index"] = c.index;
+        o["elapsedSeconds"] = c.elapsedSeconds;
+        o["loadMs"] = c.loadMs;
+        o["unloadMs"] = c.unloadMs;
+        o["calls"] = c.calls;
+        o["failures"] = c.failures;
+        o["callP50Ms"] = c.callP50Ms;
+        o["callMeanMs"] = c.callMeanMs;
+        o["eventsReceived"] = c.eventsReceived;
+        o["viewerRssBytes"] = c.viewerRssBytes;
+        o["viewerFds"] = c.viewerFds;
+        o["viewerThreads"] = c.viewerThreads;
+        o["hostProcesses"] = c.hostProcesses;
+        o["hostRssBytes"] = c.hostRssBytes;
+        o["hostFds"] = c.hostFds;
+        o["hostThreads"] = c.hostThreads;
+        o["lingeringHosts"] = c.lingeringHosts;
+        if (!c.error.isEmpty()) {
+            o["error"] = c.error;
+        }
+        cycleArray.append(o);
+    }
+    obj["cycles"] = cycleArray;
+
+    QJsonArray trendArray;
+    for (const SoakTrend& t : trends) {
+        QJsonObject o;
+        o["metric"] = t.metric;
+        o["unit"] = t.unit;
+        o["first"] = t.first;
+        o["last"] = t.last;
+        o["slopePerCycle"] = t.slopePerCycle;
+        o["r2"] = t.r2;
+        o["leak"] = t.leak;
+        trendArray.append(o);
+    }
+    obj["trends"] = trendArray;
+    obj["exitCode"] = exitCode();
+    return obj;
+}
+
+int SoakTest::warmupCycles(int cycleCount)
+{
+    return qMin(cycleCount / 10 + 1, 5);
+}
+
+SoakReport SoakTest::run(const Options& options)
+{
+    SoakReport report;
+    report.modulePath = options.modulePath;
+
+    QVector<BenchmarkCall> calls;
+    bool callsLoaded = false;
+    if (!options.callsPath.isEmpty()) {
+        QString error;
+        calls = BenchmarkRunner::loadCalls(options.callsPath, &error);
+        if (!error.isEmpty()) {
+            report.error = error;
+            return report;
+        }
+        callsLoaded = true;
+    }
+
+    const int self = static_cast<int>(QCoreApplication::applicationPid());
+    // Outlives the session so a late event never touches a dead counter.
+    int eventsReceived = 0;
+    ModuleSession session;
+    QElapsedTimer total;
+    total.start();
+
+    for (int cycle = 0; ; ++cycle) {
+        if (options.cycles > 0 && cycle >= options.cycles) {
+            break;
+        }
+        if (options.durationSeconds > 0 && total.elapsed() >= options.durationSeconds * 1000LL) {
+            break;
+        }
+
+        SoakCycle c;
+        c.index = cycle;
+
+        QElapsedTimer timer;
+        timer.start();
+        QString error;
+        if (!session.load(options.modulePath, &error)) {
+            c.error = error;
+            report.cycles.append(c);
+            report.error = QString("Cycle %1: %2").arg(cycle).arg(error);
+            break;
+        }
+        session.connectionPool()->warmUp(session.moduleName());
+        c.loadMs = timer.nsecsElapsed() / 1e6;
+
+        if (!callsLoaded) {
+            calls = BenchmarkRunner::defaultCalls(session.pluginInstance(), 20);
+            callsLoaded = true;
+        }
+
+        eventsReceived = 0;
+        if (!options.events.isEmpty()) {
+            LogosAPIClient* client = session.connectionPool()->client(session.moduleName());
+            QObject* replica = session.connectionPool()->replica(session.moduleName());
+            if (client && replica) {
+                for (const QString& eventName : options.events) {
+                    client->onEvent(replica, nullptr, eventName, [&eventsReceived](const QString&, const QVariantList&) {
+                        ++eventsReceived;
+                    });
+                }
+            } else {
+                std::cout << "Warning: Could not subscribe to events in cycle " << cycle << std::endl;
+            }
+        }
+
+        const QJsonObject results = BenchmarkRunner::run(&session, calls, 0);
+        QVector<double> samples;
+        for (const QJsonValue& callValue : results.value("calls").toArray()) {
+            const QJsonObject call = callValue.toObject();
+            for (const QJsonValue& sample : call.value("samplesMs").toArray()) {
+                samples.append(sample.toDouble());
+            }
+            c.failures += call.value("failures").toInt();
+            if (call.contains("error") && c.error.isEmpty()) {
+                c.error = call.value("error").toString();
+            }
+        }
+        const LatencySummary latency = LatencySummary::fromSamples(samples);
+        c.calls = samples.size() + c.failures;
+        c.callP50Ms = latency.p50Ms;
+        c.callMeanMs = latency.meanMs;
+
+        // Let events triggered by the calls arrive before counting them.
+        settle(options.settleMs);
+        c.eventsReceived = eventsReceived;
+
+        const QList<int> hostPids = ProcessSampler::findHostPids(session.moduleName());
+        for (int pid : hostPids) {
+            ProcessCounters counters;
+            if (ProcessSampler::readCounters(pid, &counters)) {
+                ++c.hostProcesses;
+                c.hostRssBytes += counters.rssBytes;
+                c.hostFds += counters.fdCount;
+                c.hostThreads += counters.threads;
+            }
+        }
+
+        timer.restart();
+        session.unload();
+        c.unloadMs = timer.nsecsElapsed() / 1e6;
+        settle(options.settleMs);
+
+        for (int pid : hostPids) {
+            ProcessCounters counters;
+            if (ProcessSampler::readCounters(pid, &counters)) {
+                ++c.lingeringHosts;
+            }
+        }
+        ProcessCounters viewer;
+        if (ProcessSampler::readCounters(self, &viewer)) {
+            c.viewerRssBytes = viewer.rssBytes;
+            c.viewerFds = viewer.fdCount;
+            c.viewerThreads = viewer.threads;
+        }
+        c.elapsedSeconds = total.elapsed() / 1000.0;
+        report.cycles.append(c);
+
+        std::cout << "Soak cycle " << cycle << ": load " << c.loadMs << " ms, " << c.calls << " calls (p50 "
+                  << c.callP50Ms << " ms, " << c.failures << " failed), " << c.eventsReceived << " events, viewer RSS "
+                  << c.viewerRssBytes / 1024 << " KB / " << c.viewerFds << " fds / " << c.viewerThreads
+                  << " threads, host RSS " << c.hostRssBytes / 1024 << " KB / " << c.hostFds << " fds / "
+                  << c.hostThreads << " threads, " << c.lingeringHosts << " lingering hosts" << std::endl;
+    }
+
+    // Fit trends on the cycles after warm-up.
+    const int skip = warmupCycles(report.cycles.size());
+    QVector<SoakCycle> measured;
+    int afterWarmup = 0;
+    QString callError;
+    for (const SoakCycle& c : std::as_const(report.cycles)) {
+        if (c.index < skip) {
+            continue;
+        }
+        ++afterWarmup;
+        if (c.error.isEmpty()) {
+            measured.append(c);
+        } else if (callError.isEmpty()) {
+            callError = c.error;
+        }
+    }
+    // A cycle with a failing call is left out of the trends, but a run where
+    // that leaves nothing to fit has not shown that nothing leaks.
+    if (report.error.isEmpty() && afterWarmup > 0 && measured.isEmpty()) {
+        report.error = QString("A call failed in every cycle after warm-up: %1").arg(callError);
+    } else if (report.error.isEmpty() && measured.size() < 2) {
+        report.error = QString("Only %1 usable cycles after %2 warm-up cycles; at least 2 are needed")
+            .arg(measured.size())
+            .arg(skip);
+    }
+    if (measured.size() < 2) {
+        return report;
+    }
+
+    auto series = [&](auto value) {
+        QVector<double> values;
+        for (const SoakCycle& c : measured) {
+            values.append(static_cast<double>(value(c)));
+        }
+        return values;
+    };
+    const int n = measured.size();
+    auto addTrend = [&](const QString& metric, const QString& unit, const QVector<double>& values, double minimumGrowth) {
+        SoakTrend trend = SoakTrend::fit(metric, unit, values);
+        judge(&trend, minimumGrowth, n);
+        report.trends.append(trend);
+    };
+
+    const double viewerRss = measured.first().viewerRssBytes;
+    const double hostRss = measured.first().hostRssBytes;
+    addTrend("viewer RSS", "bytes", series([](const SoakCycle& c) { return c.viewerRssBytes; }),
+             qMax(1024.0 * 1024.0, viewerRss * 0.05));
+    addTrend("viewer fds", "fds", series([](const SoakCycle& c) { return c.viewerFds; }), 2.0);
+    addTrend("viewer threads", "threads", series([](const SoakCycle& c) { return c.viewerThreads; }), 2.0);
+    addTrend("host RSS", "bytes", series([](const SoakCycle& c) { return c.hostRssBytes; }),
+             qMax(1024.0 * 1024.0, hostRss * 0.05));
+    addTrend("host fds", "fds", series([](const SoakCycle& c) { return c.hostFds; }), 2.0);
+    addTrend("host threads", "threads", series([](const SoakCycle& c) { return c.hostThreads; }), 2.0);
+    addTrend("host processes", "hosts", series([](const SoakCycle& c) { return c.hostProcesses; }), 1.0);
+    // The floor keeps sub-millisecond jitter on fast calls from counting.
+    addTrend("call p50", "ms", series([](const SoakCycle& c) { return c.callP50Ms; }),
+             qMax(0.5, measured.first().callP50Ms * 0.2));
+
+    // Hosts that survive an unload pile up whether or not they trend.
+    SoakTrend lingering = SoakTrend::fit("lingering hosts", "hosts",
+                                         series([](const SoakCycle& c) { return c.lingeringHosts; }));
+    lingering.leak = measured.last().lingeringHosts > 0;
+    report.trends.append(lingering);
+
+    return report;
+}
@@ -0,0 +1,90 @@
+#ifndef SOAKTEST_H
+#define SOAKTEST_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Measurements taken in one load/subscribe/call/unload cycle.
+struct SoakCycle
+{
+    int index = 0;
+    double elapsedSeconds = 0.0;
+    double loadMs = 0.0;
+    double unloadMs = 0.0;
+    int calls = 0;
+    int failures = 0;
+    double callP50Ms = 0.0;
+    double callMeanMs = 0.0;
+    int eventsReceived = 0;
+    // This viewer process, after the module was unloaded again.
+    qint64 viewerRssBytes = 0;
+    int viewerFds = 0;
+    int viewerThreads = 0;
+    // The module's host(s) while loaded, after the calls.
+    int hostProcesses = 0;
+    qint64 hostRssBytes = 0;
+    int hostFds = 0;
+    int hostThreads = 0;
+    // Hosts still running after the module was unloaded.
+    int lingeringHosts = 0;
+    QString error;
+};
+
+// Least-squares line through a metric over cycles.
+struct SoakTrend
+{
+    QString metric;
+    QString unit;
+    double first = 0.0;
+    double last = 0.0;
+    double slopePerCycle = 0.0;
+    double r2 = 0.0;
+    bool leak = false;
+
+    static SoakTrend fit(const QString& metric, const QString& unit, const QVector<double>& values);
+};
+
+struct SoakReport
+{
+    QString modulePath;
+    QVector<SoakCycle> cycles;
+    QVector<SoakTrend> trends;
+    QString error;
+
+    bool hasLeak() const;
+    // 0 when clean, 1 when something looks like a leak, 2 when the run failed.
+    int exitCode() const;
+    QString toText() const;
+    QJsonObject toJson() const;
+};
+
+// Loads a module, subscribes to events, runs calls and unloads it again,
+// over and over, recording resource use of this process and of the
+// module's host every cycle. Growth that keeps going across cycles is
+// reported as a likely leak.
+class SoakTest
+{
+public:
+    struct Options {
+        QString modulePath;
+        // Stop after this many cycles, or this much time; whichever comes
+        // first. 0 means no limit (but at least one of them must be set).
+        int cycles = 0;
+        int durationSeconds = 0;
+        // Call file as used by --compare; empty runs the read-only methods
+        // without parameters 20 times each.
+        QString callsPath;
+        QStringList events;
+        // Pause after each unload so deferred cleanup can finish.
+        int settleMs = 250;
+    };
+
+    static SoakReport run(const Options& options);
+
+    // Cycles excluded from trend fitting while caches and pools warm up.
+    static int warmupCycles(int cycleCount);
+};
+
+#endif // SOAKTEST_H
@@ -0,0 +1,133 @@
+#include "sparklinewidget.h"
+#include "methodwatcher.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QPaintEvent>
+#include <limits>
+
+SparklineWidget::SparklineWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(90);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+void SparklineWidget::setWatcher(MethodWatcher* watcher)
+{
+    if (m_watcher) {
+        disconnect(m_watcher, nullptr, this, nullptr);
+    }
+    m_watcher = watcher;
+    if (m_watcher) {
+        connect(m_watcher, &MethodWatcher::sampleRecorded, this, qOverload<>(&QWidget::update));
+    }
+    update();
+}
+
+QSize SparklineWidget::sizeHint() const
+{
+    return QSize(320, 90);
+}
+
+void SparklineWidget::paintEvent(QPaintEvent*)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), QColor("#252525"));
+
+    if (!m_watcher || m_watcher->samples().isEmpty()) {
+        painter.setPen(QColor("#888"));
+        painter.drawText(rect(), Qt::AlignCenter, "Waiting for samples...");
+        return;
+    }
+
+    const RingBuffer<WatchSample>& samples = m_watcher->samples();
+    const int count = samples.size();
+    const QRectF area = QRectF(rect()).adjusted(4, 4, -4, -4);
+    const qreal bandGap = 6;
+    const QRectF valueBand(area.left(), area.top(), area.width(), area.height() * 0.6 - bandGap / 2);
+    const QRectF latencyBand(area.left(), valueBand.bottom() + bandGap, area.width(),
+                             area.bottom() - valueBand.bottom() - bandGap);
+
+    // Newest sample sits at the right edge; the buffer fills in from there.
+    const qreal step = samples.capacity() > 1 ? area.width() / (samples.capacity() - 1) : area.width();
+    auto xAt = [&](int i) { return area.right() - (count - 1 - i) * step; };
+
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    double maxLatency = 0.0;
+    bool anyNumeric = false;
+    for (int i = 0; i < count; ++i) {
+        const WatchSample& s = samples.at(i);
+        maxLatency = qMax(maxLatency, s.latencyMs);
+        if (s.ok && s.numeric) {
+            minValue = qMin(minValue, s.value);
+            maxValue = qMax(maxValue, s.value);
+            anyNumeric = true;
+        }
+    }
+    if (anyNumeric && qFuzzyCompare(minValue + 1.0, maxValue + 1.0)) {
+        minValue -= 1.0;
+        maxValue += 1.0;
+    }
+
+    painter.setPen(QColor("#3d3d3d"));
+    painter.drawRect(valueBand);
+    painter.drawRect(latencyBand);
+
+    QPainterPath valuePath;
+    bool pathStarted = false;
+    for (int i = 0; i < count; ++i) {
+        const WatchSample& s = samples.at(i);
+        const qreal x = xAt(i);
+        if (!s.ok) {
+            painter.setPen(QPen(QColor("#ff6b6b"), 2));
+            painter.drawLine(QPointF(x, valueBand.bottom() - 6), QPointF(x, valueBand.bottom()));
+            pathStarted = false;
+            continue;
+        }
+        if (s.numeric && anyNumeric) {
+            const qreal y = valueBand.bottom() - (s.value - minValue) / (maxValue - minValue) * valueBand.height();
+            if (pathStarted) {
+                valuePath.lineTo(x, y);
+            } else {
+                valuePath.moveTo(x, y);
+                pathStarted = true;
+            }
+        } else if (s.changed) {
+            painter.setPen(QPen(QColor("#e0b050"), 2));
+            painter.drawLine(QPointF(x, valueBand.top()), QPointF(x, valueBand.bottom()));
+        }
+    }
+    painter.setPen(QPen(QColor("#5a9"), 1.5));
+    painter.drawPath(valuePath);
+
+    QPainterPath latencyPath;
+    for (int i = 0; i < count; ++i) {
+        const qreal ratio = maxLatency > 0 ? samples.at(i).latencyMs / maxLatency : 0.0;
+        const QPointF point(xAt(i), latencyBand.bottom() - ratio * latencyBand.height());
+        if (i == 0) {
+            latencyPath.moveTo(point);
+        } else {
+            latencyPath.lineTo(point);
+        }
+    }
+    painter.setPen(QPen(QColor("#6bb"), 1.2));
+    painter.drawPath(latencyPath);
+
+    QFont labelFont = font();
+    labelFont.setPointSizeF(qMax(7.0, labelFont.pointSizeF() - 2));
+    painter.setFont(labelFont);
+    painter.setPen(QColor("#888"));
+    if (anyNumeric) {
+        painter.drawText(valueBand.adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignLeft,
+                         QString::number(maxValue, 'g', 6));
+        painter.drawText(valueBand.adjusted(4, 2, -4, -2), Qt::AlignBottom | Qt::AlignLeft,
+                         QString::number(minValue, 'g', 6));
+    } else {
+        painter.drawText(valueBand.adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignLeft, "changes");
+    }
+    painter.drawText(latencyBand.adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignLeft,
+                     QString("latency max %1 ms").arg(maxLatency, 0, 'f', 2));
+}
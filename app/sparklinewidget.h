@@ -0,0 +1,29 @@
+#ifndef SPARKLINEWIDGET_H
+#define SPARKLINEWIDGET_H
+
+#include <QWidget>
+#include <QPointer>
+
+class MethodWatcher;
+
+// Draws the samples held by a MethodWatcher: returned values on top (or
+// change ticks for non-numeric results) and call latency underneath.
+class SparklineWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SparklineWidget(QWidget* parent = nullptr);
+
+    void setWatcher(MethodWatcher* watcher);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QPointer<MethodWatcher> m_watcher;
+};
+
+#endif // SPARKLINEWIDGET_H